@@ -24,6 +24,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/ptr.h"
 #include "common/stream.h"
@@ -72,6 +73,23 @@ protected:
 	// This buffer contains a slab of input data
 	byte _buf[BUFFER_SIZE + MAD_BUFFER_GUARD];
 
+	enum {
+		// Number of frames between two entries of the seek table
+		SEEK_TABLE_INTERVAL = 16
+	};
+
+	/**
+	 * An entry of the seek table: the playback time at the start of a
+	 * frame together with the position of that frame in the input stream.
+	 */
+	struct SeekPoint {
+		mad_timer_t time;
+		int32 offset;
+	};
+
+	// Sparse time -> byte offset index, built while calculating the length
+	Common::Array<SeekPoint> _seekTable;
+
 public:
 	MP3Stream(Common::SeekableReadStream *inStream,
 	               DisposeAfterUse::Flag dispose);
@@ -89,9 +107,12 @@ protected:
 	void decodeMP3Data();
 	void readMP3Data();
 
-	void initStream();
+	void initStream(int32 offset = 0, mad_timer_t startTime = mad_timer_zero);
 	void readHeader();
 	void deinitStream();
+
+	void addSeekPoint(mad_timer_t startTime);
+	const SeekPoint *findSeekPoint(mad_timer_t destination) const;
 };
 
 MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
@@ -106,12 +127,20 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	// may read a few bytes beyond the end of the input buffer).
 	memset(_buf + BUFFER_SIZE, 0, MAD_BUFFER_GUARD);
 
-	// Calculate the length of the stream
+	// Calculate the length of the stream. While at it, remember the
+	// position of every SEEK_TABLE_INTERVAL-th frame so that seek() does
+	// not need to scan all headers from the start of the stream again.
 	initStream();
 
-	while (_state != MP3_STATE_EOS)
+	uint frameCount = 0;
+	while (_state != MP3_STATE_EOS) {
+		const mad_timer_t frameStart = _totalTime;
 		readHeader();
 
+		if (_state == MP3_STATE_READY && (frameCount++ % SEEK_TABLE_INTERVAL) == 0)
+			addSeekPoint(frameStart);
+	}
+
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
 	// We need to assure this, since else we might trigger an assertion in Timestamp
@@ -220,8 +249,17 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _totalTime) < 0)
-		initStream();
+	// Jump to the closest indexed frame in front of the destination, unless
+	// scanning forward from the current position is cheaper anyway.
+	const SeekPoint *seekPoint = findSeekPoint(destination);
+
+	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _totalTime) < 0 ||
+	    (seekPoint && mad_timer_compare(seekPoint->time, _totalTime) > 0)) {
+		if (seekPoint)
+			initStream(seekPoint->offset, seekPoint->time);
+		else
+			initStream();
+	}
 
 	while (mad_timer_compare(destination, _totalTime) > 0 && _state != MP3_STATE_EOS)
 		readHeader();
@@ -231,7 +269,35 @@ bool MP3Stream::seek(const Timestamp &where) {
 	return (_state != MP3_STATE_EOS);
 }
 
-void MP3Stream::initStream() {
+void MP3Stream::addSeekPoint(mad_timer_t startTime) {
+	// After decoding a header, this_frame points to the start of that frame
+	// inside _buf, which holds the data up to the current stream position.
+	SeekPoint point;
+	point.time = startTime;
+	point.offset = _inStream->pos() - (int32)(_stream.bufend - _stream.this_frame);
+	_seekTable.push_back(point);
+}
+
+const MP3Stream::SeekPoint *MP3Stream::findSeekPoint(mad_timer_t destination) const {
+	// Binary search for the last entry starting at or before the destination
+	int low = 0, high = (int)_seekTable.size() - 1;
+	const SeekPoint *result = 0;
+
+	while (low <= high) {
+		const int mid = (low + high) / 2;
+
+		if (mad_timer_compare(_seekTable[mid].time, destination) <= 0) {
+			result = &_seekTable[mid];
+			low = mid + 1;
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	return result;
+}
+
+void MP3Stream::initStream(int32 offset, mad_timer_t startTime) {
 	if (_state != MP3_STATE_INIT)
 		deinitStream();
 
@@ -241,8 +307,8 @@ void MP3Stream::initStream() {
 	mad_synth_init(&_synth);
 
 	// Reset the stream data
-	_inStream->seek(0, SEEK_SET);
-	_totalTime = mad_timer_zero;
+	_inStream->seek(offset, SEEK_SET);
+	_totalTime = startTime;
 	_posInFrame = 0;
 
 	// Update state
@@ -121,6 +121,18 @@ public:
 
 	// TODO: Document this.
 	virtual void metaEvent(byte type, byte *data, uint16 length) { }
+
+	/**
+	 * Announce that the events sent next are due the given number of
+	 * microseconds after the start of the current timer tick. MidiParser
+	 * calls this from its timer callback before sending each event.
+	 *
+	 * Drivers which render their output themselves can use this to apply
+	 * events at their exact position in the output instead of at the start
+	 * of the tick. Drivers passing on events to another driver should pass
+	 * this on as well.
+	 */
+	virtual void setEventDelay(uint32 delay) { }
 };
 
 /**
@@ -178,6 +178,7 @@ void MidiParser::onTimer() {
 		for (i = ARRAYSIZE(_hanging_notes); i; --i, ++ptr) {
 			if (ptr->time_left) {
 				if (ptr->time_left <= _timer_rate) {
+					_driver->setEventDelay(ptr->time_left);
 					sendToDriver(0x80 | ptr->channel, ptr->note, 0);
 					ptr->time_left = 0;
 					--_hanging_notes_count;
@@ -195,6 +196,9 @@ void MidiParser::onTimer() {
 		if (event_time > end_time)
 			break;
 
+		// Let the driver know when exactly within this tick the event is due
+		_driver->setEventDelay(event_time > _position._play_time ? event_time - _position._play_time : 0);
+
 		// Process the next info.
 		_position._last_event_tick += info.delta;
 		if (info.event < 0x80) {
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -173,7 +174,8 @@ private:
 
 
 MixerImpl::MixerImpl(OSystem *system, uint sampleRate)
-	: _syst(system), _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _syst(system), _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _statCalls(0), _statLateCalls(0), _statWorstMicros(0), _statWorstLength(0) {
 
 	assert(sampleRate > 0);
 
@@ -268,6 +270,9 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
 	Common::StackLock lock(_mutex);
+	PROFILE_SCOPE("mixer callback");
+
+	const uint32 startMicros = _syst->getMicros();
 
 	int16 *buf = (int16 *)samples;
 	// we store stereo, 16-bit samples
@@ -295,9 +300,41 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 			}
 		}
 
+	// If mixing takes longer than playing the result, the backend runs
+	// out of output: e.g. emulated synths are too slow for the host, or
+	// the backend's buffer is too small.
+	const uint32 micros = _syst->getMicros() - startMicros;
+	_statCalls++;
+	if ((double)micros * _sampleRate > (double)len * 1000000)
+		_statLateCalls++;
+	if (micros > _statWorstMicros) {
+		_statWorstMicros = micros;
+		_statWorstLength = len;
+	}
+
 	return res;
 }
 
+Common::Array<Common::String> MixerImpl::formatStats() {
+	Common::StackLock lock(_mutex);
+	Common::Array<Common::String> lines;
+
+	lines.push_back(Common::String::format("Output rate: %d Hz", _sampleRate));
+	lines.push_back(Common::String::format("Callbacks: %d, late: %d", _statCalls, _statLateCalls));
+	lines.push_back(Common::String::format("Longest callback: %d us for %d us of output",
+	                                       _statWorstMicros, (int)((double)_statWorstLength * 1000000 / _sampleRate)));
+
+	return lines;
+}
+
+void MixerImpl::resetStats() {
+	Common::StackLock lock(_mutex);
+	_statCalls = 0;
+	_statLateCalls = 0;
+	_statWorstMicros = 0;
+	_statWorstLength = 0;
+}
+
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -604,6 +641,7 @@ int Channel::mix(int16 *data, uint len) {
 		// TODO: call drain method
 	} else {
 		assert(_converter);
+		PROFILE_SCOPE("rate conversion");
 		_samplesConsumed = _samplesDecoded;
 		_mixerTimeStamp = g_system->getMillis();
 		_pauseTime = 0;
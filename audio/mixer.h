@@ -24,7 +24,9 @@
 #define SOUND_MIXER_H
 
 #include "common/types.h"
+#include "common/array.h"
 #include "common/noncopyable.h"
+#include "common/str.h"
 
 namespace Audio {
 
@@ -277,6 +279,18 @@ public:
 	 * @return the output sample rate in Hz
 	 */
 	virtual uint getOutputRate() const = 0;
+
+	/**
+	 * Return statistics on how long mixing the output took, compared to
+	 * the time it takes to play. Mixers which don't keep any statistics
+	 * return an empty list.
+	 */
+	virtual Common::Array<Common::String> formatStats() { return Common::Array<Common::String>(); }
+
+	/**
+	 * Reset the statistics returned by formatStats().
+	 */
+	virtual void resetStats() {}
 };
 
 
@@ -71,6 +71,12 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	// Statistics of mixCallback(), see formatStats()
+	uint32 _statCalls;
+	uint32 _statLateCalls;      ///< Calls which took longer than their output plays
+	uint32 _statWorstMicros;    ///< Longest time spent in a call
+	uint32 _statWorstLength;    ///< Number of samples mixed in that call
+
 
 public:
 
@@ -119,6 +125,9 @@ public:
 
 	virtual uint getOutputRate() const;
 
+	virtual Common::Array<Common::String> formatStats();
+	virtual void resetStats();
+
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
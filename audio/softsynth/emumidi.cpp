@@ -0,0 +1,141 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include "audio/softsynth/emumidi.h"
+
+#include "common/util.h"
+
+MidiDriver_Emulated::~MidiDriver_Emulated() {
+	delete[] _aheadBuf;
+}
+
+int MidiDriver_Emulated::open() {
+	_isOpen = true;
+
+	int d = getRate() / _baseFreq;
+	int r = getRate() % _baseFreq;
+
+	// This is equivalent to (getRate() << FIXP_SHIFT) / BASE_FREQ
+	// but less prone to arithmetic overflow.
+
+	_samplesPerTick = (d << FIXP_SHIFT) + (r << FIXP_SHIFT) / _baseFreq;
+
+	// Events are never rendered further ahead than the next tick
+	delete[] _aheadBuf;
+	_aheadSize = (_samplesPerTick >> FIXP_SHIFT) + 1;
+	_aheadBuf = new int16[_aheadSize * 2];
+	_aheadLen = 0;
+	_renderedAhead = 0;
+
+	return 0;
+}
+
+void MidiDriver_Emulated::setEventDelay(uint32 delay) {
+	// Only events sent from the timer callback have a known position in
+	// the output, all others are applied right away.
+	if (!_inTimerProc)
+		return;
+
+	const int rate = getRate();
+	int len = (delay / 1000) * rate / 1000 + (delay % 1000) * rate / 1000000;
+
+	// onTimer() has to be applied at the start of the next tick
+	len = MIN(len, _nextTick >> FIXP_SHIFT);
+
+	renderAhead(len);
+}
+
+void MidiDriver_Emulated::renderAhead(int len) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+
+	// Events from several senders are not necessarily in order. Those
+	// due before what was already rendered are applied late, as before.
+	while (_renderedAhead < len) {
+		const int pos = _timerBufPos + _renderedAhead;
+		int step;
+
+		if (pos < _timerBufLen) {
+			step = MIN(len - _renderedAhead, _timerBufLen - pos);
+			generateSamples(_timerBuf + pos * stereoFactor, step);
+		} else {
+			// Past the end of the mixer buffer, keep the samples for the
+			// next call of readBuffer()
+			step = len - _renderedAhead;
+			assert(pos - _timerBufLen == _aheadLen && _aheadLen + step <= _aheadSize);
+			generateSamples(_aheadBuf + _aheadLen * stereoFactor, step);
+			_aheadLen += step;
+		}
+
+		_renderedAhead += step;
+	}
+}
+
+int MidiDriver_Emulated::readBuffer(int16 *data, const int numSamples) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	const int len = numSamples / stereoFactor;
+
+	// Hand out what was rendered ahead during the previous call
+	if (_aheadLen) {
+		const int copyLen = MIN(len, _aheadLen);
+		memcpy(data, _aheadBuf, copyLen * stereoFactor * sizeof(int16));
+
+		_aheadLen -= copyLen;
+		memmove(_aheadBuf, _aheadBuf + copyLen * stereoFactor, _aheadLen * stereoFactor * sizeof(int16));
+	}
+
+	int pos = 0;
+
+	do {
+		int step = len - pos;
+		if (step > (_nextTick >> FIXP_SHIFT))
+			step = (_nextTick >> FIXP_SHIFT);
+
+		// Skip the samples the timer callback already rendered
+		const int rendered = MIN(step, _renderedAhead);
+		if (step > rendered)
+			generateSamples(data + (pos + rendered) * stereoFactor, step - rendered);
+		_renderedAhead -= rendered;
+
+		pos += step;
+
+		_nextTick -= step << FIXP_SHIFT;
+		if (!(_nextTick >> FIXP_SHIFT)) {
+			_nextTick += _samplesPerTick;
+
+			// This comes first, so that the state at the start of the tick
+			// is in place when events render ahead.
+			onTimer();
+
+			if (_timerProc) {
+				_timerBuf = data;
+				_timerBufLen = len;
+				_timerBufPos = pos;
+
+				_inTimerProc = true;
+				(*_timerProc)(_timerParam);
+				_inTimerProc = false;
+			}
+		}
+	} while (pos < len);
+
+	return numSamples;
+}
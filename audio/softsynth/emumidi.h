@@ -26,6 +26,19 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+/**
+ * Base class for MIDI drivers which render their output themselves, e.g. by
+ * emulating a synthesizer. The output is an audio stream which is played by
+ * the mixer, and the timer callback is called from within the rendering
+ * loop, _baseFreq times per second.
+ *
+ * MIDI events sent from the timer callback are applied at their exact
+ * sample position if the sender announces their time through
+ * setEventDelay(), as MidiParser does: the output is rendered up to that
+ * position before the event reaches the driver. Output which lies beyond
+ * the end of the current mixer buffer is kept until the next call of
+ * readBuffer().
+ */
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -43,6 +56,20 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	// Output rendered ahead of the mixer, see setEventDelay()
+	int16 *_aheadBuf;
+	int _aheadLen;
+	int _aheadSize;
+	int _renderedAhead; ///< Number of samples rendered beyond the current position
+
+	// The mixer buffer the timer callback is called from
+	bool _inTimerProc;
+	int16 *_timerBuf;
+	int _timerBufLen;
+	int _timerBufPos;
+
+	void renderAhead(int len);
+
 protected:
 	int _baseFreq;
 
@@ -57,23 +84,21 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_aheadBuf(0),
+		_aheadLen(0),
+		_aheadSize(0),
+		_renderedAhead(0),
+		_inTimerProc(false),
+		_timerBuf(0),
+		_timerBufLen(0),
+		_timerBufPos(0),
 		_baseFreq(250) {
 	}
 
-	// MidiDriver API
-	virtual int open() {
-		_isOpen = true;
-
-		int d = getRate() / _baseFreq;
-		int r = getRate() % _baseFreq;
-
-		// This is equivalent to (getRate() << FIXP_SHIFT) / BASE_FREQ
-		// but less prone to arithmetic overflow.
+	virtual ~MidiDriver_Emulated();
 
-		_samplesPerTick = (d << FIXP_SHIFT) + (r << FIXP_SHIFT) / _baseFreq;
-
-		return 0;
-	}
+	// MidiDriver API
+	virtual int open();
 
 	bool isOpen() const { return _isOpen; }
 
@@ -86,35 +111,10 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
-	// AudioStream API
-	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
-
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
+	virtual void setEventDelay(uint32 delay);
 
-				onTimer();
-
-				_nextTick += _samplesPerTick;
-			}
-
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
-
-		return numSamples;
-	}
+	// AudioStream API
+	virtual int readBuffer(int16 *data, const int numSamples);
 
 	virtual bool endOfData() const {
 		return false;
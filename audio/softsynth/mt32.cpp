@@ -35,6 +35,7 @@
 #include "common/error.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/util.h"
 #include "common/archive.h"
@@ -60,6 +61,30 @@ private:
 
 	int _outputRate;
 
+	// Samples which have been requested by the mixer but not rendered yet.
+	// Consecutive requests are merged and rendered as one block right
+	// before the next MIDI event reaches the synth.
+	int16 *_pendingBuf;
+	int _pendingLen;
+
+	// MIDI events are sent from the engine's threads as well as from the
+	// timer callback, but the synth only renders from within readBuffer(),
+	// into the mixer's buffer. So events are queued, and applied by the
+	// mixer thread once the samples before them are rendered.
+	struct QueuedEvent {
+		uint32 msg;          ///< The message, unless this is a SysEx
+		uint32 sysExOffset;  ///< Start of the SysEx in _sysExData
+		uint16 sysExLength;
+	};
+
+	Common::Mutex _eventMutex; ///< Guards the event queue
+	Common::Array<QueuedEvent> _events;
+	Common::Array<byte> _sysExData;
+
+	void renderPendingSamples();
+	void applyEvents();
+	void playSysEx(const byte *msg, uint16 length);
+
 protected:
 	void generateSamples(int16 *buf, int len);
 
@@ -80,6 +105,7 @@ public:
 	MidiChannel *getPercussionChannel();
 
 	// AudioStream API
+	int readBuffer(int16 *data, const int numSamples);
 	bool isStereo() const { return true; }
 	int getRate() const { return _outputRate; }
 };
@@ -285,6 +311,8 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	// rely on Mixer to convert.
 	_outputRate = 32000; //_mixer->getOutputRate();
 	_initializing = false;
+	_pendingBuf = NULL;
+	_pendingLen = 0;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -344,7 +372,18 @@ int MidiDriver_MT32::open() {
 }
 
 void MidiDriver_MT32::send(uint32 b) {
-	_synth->playMsg(b);
+	// Without a running mixer, nothing is rendered concurrently
+	if (!_mixer->isReady()) {
+		_synth->playMsg(b);
+		return;
+	}
+
+	Common::StackLock lock(_eventMutex);
+	QueuedEvent event;
+	event.msg = b;
+	event.sysExOffset = 0;
+	event.sysExLength = 0;
+	_events.push_back(event);
 }
 
 void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
@@ -365,6 +404,22 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 }
 
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
+	if (!_mixer->isReady()) {
+		playSysEx(msg, length);
+		return;
+	}
+
+	Common::StackLock lock(_eventMutex);
+	QueuedEvent event;
+	event.msg = 0;
+	event.sysExOffset = _sysExData.size();
+	event.sysExLength = length;
+	_events.push_back(event);
+	for (uint16 i = 0; i < length; ++i)
+		_sysExData.push_back(msg[i]);
+}
+
+void MidiDriver_MT32::playSysEx(const byte *msg, uint16 length) {
 	if (msg[0] == 0xf0) {
 		_synth->playSysex(msg, length);
 	} else {
@@ -382,13 +437,75 @@ void MidiDriver_MT32::close() {
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	_pendingBuf = NULL;
+	_pendingLen = 0;
+
+	{
+		Common::StackLock lock(_eventMutex);
+		_events.clear();
+		_sysExData.clear();
+	}
+
 	_synth->close();
 	delete _synth;
 	_synth = NULL;
 }
 
+int MidiDriver_MT32::readBuffer(int16 *data, const int numSamples) {
+	const int result = MidiDriver_Emulated::readBuffer(data, numSamples);
+	renderPendingSamples();
+	applyEvents();
+	return result;
+}
+
 void MidiDriver_MT32::generateSamples(int16 *data, int len) {
-	_synth->render(data, len);
+	// With our high base frequency, this is called for only a few samples
+	// at a time. The synth state only changes through MIDI events, so
+	// instead of rendering each tick separately we collect the samples
+	// and render them in one go once an event is queued or the mixer
+	// buffer is complete. This saves the per call overhead of the partial
+	// and reverb processing.
+	if (_pendingLen && data != _pendingBuf + _pendingLen * 2)
+		renderPendingSamples();
+
+	applyEvents();
+
+	if (!_pendingLen)
+		_pendingBuf = data;
+	_pendingLen += len;
+}
+
+void MidiDriver_MT32::applyEvents() {
+	{
+		Common::StackLock lock(_eventMutex);
+		if (_events.empty())
+			return;
+	}
+
+	// The samples before the events have to be rendered without them.
+	// This is done without holding the lock, so that senders don't wait.
+	renderPendingSamples();
+
+	Common::StackLock lock(_eventMutex);
+	for (uint i = 0; i < _events.size(); ++i) {
+		const QueuedEvent &event = _events[i];
+		if (event.sysExLength)
+			playSysEx(&_sysExData[event.sysExOffset], event.sysExLength);
+		else
+			_synth->playMsg(event.msg);
+	}
+
+	_events.clear();
+	_sysExData.clear();
+}
+
+void MidiDriver_MT32::renderPendingSamples() {
+	if (!_pendingLen)
+		return;
+
+	_synth->render(_pendingBuf, _pendingLen);
+	_pendingBuf = NULL;
+	_pendingLen = 0;
 }
 
 uint32 MidiDriver_MT32::property(int prop, uint32 param) {
@@ -1116,11 +1116,11 @@ void ProduceOutput1(Bit16s *useBuf, Bit16s *stream, Bit32u len, Bit16s volume) {
 	stream += donelen * 2;
 	useBuf += donelen * 2;
 #endif
-	int end = len * 2;
-	while (end--) {
-		*stream = *stream + (Bit16s)(((Bit32s)*useBuf++ * (Bit32s)volume)>>15);
-		stream++;
-	}
+	// Plain indexed loop, so that compilers can vectorize it on targets
+	// without the i386 helpers above
+	const int end = len * 2;
+	for (int i = 0; i < end; i++)
+		stream[i] = stream[i] + (Bit16s)(((Bit32s)useBuf[i] * (Bit32s)volume) >> 15);
 }
 
 void Synth::render(Bit16s *stream, Bit32u len) {
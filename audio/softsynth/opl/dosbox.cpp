@@ -297,6 +297,10 @@ void OPL::readBuffer(int16 *buffer, int length) {
 	if (_type != Config::kOpl2)
 		length >>= 1;
 
+	// The emulator mixes all channels into 32 bit samples. With both
+	// chips of a dual OPL2 or all 18 OPL3 channels playing, the sum can
+	// exceed the 16 bit range, so we need to clip it instead of just
+	// truncating it, which would cause audible wrap around distortion.
 	const uint bufferLength = 512;
 	int32 tempBuffer[bufferLength * 2];
 
@@ -307,7 +311,7 @@ void OPL::readBuffer(int16 *buffer, int length) {
 			_emulator->GenerateBlock3(readSamples, tempBuffer);
 
 			for (uint i = 0; i < (readSamples << 1); ++i)
-				buffer[i] = tempBuffer[i];
+				buffer[i] = CLIP<int32>(tempBuffer[i], -32768, 32767);
 
 			buffer += (readSamples << 1);
 			length -= readSamples;
@@ -319,7 +323,7 @@ void OPL::readBuffer(int16 *buffer, int length) {
 			_emulator->GenerateBlock2(readSamples, tempBuffer);
 
 			for (uint i = 0; i < readSamples; ++i)
-				buffer[i] = tempBuffer[i];
+				buffer[i] = CLIP<int32>(tempBuffer[i], -32768, 32767);
 
 			buffer += readSamples;
 			length -= readSamples;
@@ -25,11 +25,28 @@
 
 #include "backends/graphics/graphics.h"
 
+#include "common/EventRecorder.h"
+
+#include "graphics/surface.h"
+
 static const OSystem::GraphicsMode s_noGraphicsModes[] = { {0, 0, 0} };
 
-class NullGraphicsManager : GraphicsManager {
+/**
+ * Graphics manager without any display.
+ *
+ * The game screen is still kept in memory, so that engines can lock and
+ * read it back and so that the event recorder can hash every frame which
+ * would have been presented.
+ */
+class NullGraphicsManager : public GraphicsManager {
 public:
-	virtual ~NullGraphicsManager() {}
+	NullGraphicsManager() {
+		memset(_palette, 0, sizeof(_palette));
+	}
+
+	virtual ~NullGraphicsManager() {
+		_screen.free();
+	}
 
 	bool hasFeature(OSystem::Feature f) { return false; }
 	void setFeatureState(OSystem::Feature f, bool enable) {}
@@ -38,30 +55,52 @@ public:
 	const OSystem::GraphicsMode *getSupportedGraphicsModes() const { return s_noGraphicsModes; }
 	int getDefaultGraphicsMode() const { return 0; }
 	bool setGraphicsMode(int mode) { return true; }
+	void resetGraphicsScale() {}
 	int getGraphicsMode() const { return 0; }
 	inline Graphics::PixelFormat getScreenFormat() const {
-		return Graphics::PixelFormat::createFormatCLUT8();
+		return _screen.pixels ? _screen.format : Graphics::PixelFormat::createFormatCLUT8();
 	}
 	inline Common::List<Graphics::PixelFormat> getSupportedFormats() const {
 		Common::List<Graphics::PixelFormat> list;
 		list.push_back(Graphics::PixelFormat::createFormatCLUT8());
 		return list;
 	}
-	void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) {}
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) {
+		_screen.free();
+		_screen.create(width, height, format ? *format : Graphics::PixelFormat::createFormatCLUT8());
+	}
 	virtual int getScreenChangeID() const { return 0; }
 
 	void beginGFXTransaction() {}
 	OSystem::TransactionError endGFXTransaction() { return OSystem::kTransactionSuccess; }
 
-	int16 getHeight() { return 0; }
-	int16 getWidth() { return 0; }
-	void setPalette(const byte *colors, uint start, uint num) {}
-	void grabPalette(byte *colors, uint start, uint num) {}
-	void copyRectToScreen(const byte *buf, int pitch, int x, int y, int w, int h) {}
-	Graphics::Surface *lockScreen() { return NULL; }
+	int16 getHeight() { return _screen.h; }
+	int16 getWidth() { return _screen.w; }
+	void setPalette(const byte *colors, uint start, uint num) {
+		memcpy(_palette + start * 3, colors, num * 3);
+	}
+	void grabPalette(byte *colors, uint start, uint num) {
+		memcpy(colors, _palette + start * 3, num * 3);
+	}
+	void copyRectToScreen(const byte *buf, int pitch, int x, int y, int w, int h) {
+		const int bytesPerPixel = _screen.format.bytesPerPixel;
+		byte *dst = (byte *)_screen.getBasePtr(x, y);
+
+		while (h--) {
+			memcpy(dst, buf, w * bytesPerPixel);
+			dst += _screen.pitch;
+			buf += pitch;
+		}
+	}
+	Graphics::Surface *lockScreen() { return &_screen; }
 	void unlockScreen() {}
-	void fillScreen(uint32 col) {}
-	void updateScreen() {}
+	void fillScreen(uint32 col) {
+		_screen.fillRect(Common::Rect(_screen.w, _screen.h), col);
+	}
+	void updateScreen() {
+		g_eventRec.processScreenUpdate((const byte *)_screen.pixels, _screen.pitch, _screen.w, _screen.h, _screen.format.bytesPerPixel,
+		                               _screen.format.bytesPerPixel == 1 ? _palette : 0);
+	}
 	void setShakePos(int shakeOffset) {}
 	void setFocusRectangle(const Common::Rect& rect) {}
 	void clearFocusRectangle() {}
@@ -79,6 +118,10 @@ public:
 	void warpMouse(int x, int y) {}
 	void setMouseCursor(const byte *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, int cursorTargetScale = 1, const Graphics::PixelFormat *format = NULL) {}
 	void setCursorPalette(const byte *colors, uint start, uint num) {}
+
+private:
+	Graphics::Surface _screen;
+	byte _palette[256 * 3];
 };
 
 #endif
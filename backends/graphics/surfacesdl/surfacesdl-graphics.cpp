@@ -29,6 +29,7 @@
 #include "backends/platform/sdl/sdl.h"
 #include "common/config-manager.h"
 #include "common/mutex.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/util.h"
@@ -1049,6 +1050,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 
 	// Only draw anything if necessary
 	if (_numDirtyRects > 0 || _mouseNeedsRedraw) {
+		PROFILE_SCOPE("screen scaler");
 		SDL_Rect *r;
 		SDL_Rect dst;
 		uint32 srcPitch, dstPitch;
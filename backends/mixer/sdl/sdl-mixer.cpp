@@ -117,6 +117,16 @@ SDL_AudioSpec SdlMixerManager::getAudioSpec(uint32 outputRate) {
 	while (samples * 16 > samplesPerSec * 2)
 		samples >>= 1;
 
+	// A smaller buffer lowers the latency, but needs a host which mixes
+	// fast enough; the debugger's "mixer" command shows if it doesn't.
+	if (ConfMan.hasKey("audio_buffer_size")) {
+		const int size = ConfMan.getInt("audio_buffer_size");
+		if (size >= 256 && size <= 8192 && !(size & (size - 1)))
+			samples = size;
+		else
+			warning("Ignoring invalid audio_buffer_size %d, it must be a power of two between 256 and 8192", size);
+	}
+
 	memset(&desired, 0, sizeof(desired));
 	desired.freq = samplesPerSec;
 	desired.format = AUDIO_S16SYS;
@@ -74,6 +74,8 @@ AbstractFSNode *BadaFilesystemFactory::makeFileNodePath(const Common::String &pa
 //
 struct BadaSaveFileManager : public DefaultSaveFileManager {
 	bool removeSavefile(const Common::String &filename);
+	// removeSavefile() doesn't drop the save index
+	bool supportsSaveIndex() const { return false; }
 };
 
 bool BadaSaveFileManager::removeSavefile(const Common::String &filename) {
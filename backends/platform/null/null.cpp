@@ -20,15 +20,31 @@
  *
  */
 
+#define FORBIDDEN_SYMBOL_EXCEPTION_FILE
+#define FORBIDDEN_SYMBOL_EXCEPTION_stdout
+#define FORBIDDEN_SYMBOL_EXCEPTION_stderr
+#define FORBIDDEN_SYMBOL_EXCEPTION_fputs
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+
 #include "backends/modular-backend.h"
 #include "base/main.h"
 
 #if defined(USE_NULL_DRIVER)
+#include "backends/events/default/default-events.h"
+#include "backends/graphics/null/null-graphics.h"
+#include "backends/mutex/null/null-mutex.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "audio/mixer_intern.h"
+#include "common/EventRecorder.h"
 #include "common/scummsys.h"
 
+#if defined(POSIX)
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
 /*
  * Include header files needed for the getFilesystemFactory() method.
  */
@@ -40,7 +56,10 @@
 	#include "backends/fs/windows/windows-fs-factory.h"
 #endif
 
-class OSystem_NULL : public ModularBackend {
+class OSystem_NULL : public ModularBackend, Common::EventSource {
+protected:
+	virtual Common::EventSource *getDefaultEventSource() { return this; }
+
 public:
 	OSystem_NULL();
 	virtual ~OSystem_NULL();
@@ -50,10 +69,16 @@ public:
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual uint32 getMillis();
+	virtual uint32 getMicros();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &t) const {}
 
 	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+private:
+#if defined(POSIX)
+	timeval _startTime;
+#endif
 };
 
 OSystem_NULL::OSystem_NULL() {
@@ -75,6 +100,9 @@ void OSystem_NULL::initBackend() {
 	_mutexManager = new NullMutexManager();
 	_timerManager = new DefaultTimerManager();
 	_eventManager = new DefaultEventManager(this);
+#if defined(POSIX)
+	gettimeofday(&_startTime, 0);
+#endif
 	_savefileManager = new DefaultSaveFileManager();
 	_graphicsManager = new NullGraphicsManager();
 	_mixer = new Audio::MixerImpl(this, 22050);
@@ -93,10 +121,37 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 uint32 OSystem_NULL::getMillis() {
-	return 0;
+	uint32 millis = 0;
+
+#if defined(POSIX)
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	millis = (uint32)(((curTime.tv_sec - _startTime.tv_sec) * 1000) +
+	                  ((curTime.tv_usec - _startTime.tv_usec) / 1000));
+#endif
+
+	g_eventRec.processMillis(millis);
+	return millis;
+}
+
+uint32 OSystem_NULL::getMicros() {
+#if defined(POSIX)
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	return (uint32)(((curTime.tv_sec - _startTime.tv_sec) * 1000000) +
+	                (curTime.tv_usec - _startTime.tv_usec));
+#else
+	return getMillis() * 1000;
+#endif
 }
 
 void OSystem_NULL::delayMillis(uint msecs) {
+	if (g_eventRec.processDelayMillis(msecs))
+		return;
+
+#if defined(POSIX)
+	usleep(msecs * 1000);
+#endif
 }
 
 void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
@@ -37,16 +37,22 @@
 
 #include <errno.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
 
 OSystem_POSIX::OSystem_POSIX(Common::String baseConfigName)
 	:
-	_baseConfigName(baseConfigName) {
+	_baseConfigName(baseConfigName),
+	_startSeconds(0) {
 }
 
 void OSystem_POSIX::init() {
+	timeval startTime;
+	gettimeofday(&startTime, 0);
+	_startSeconds = startTime.tv_sec;
+
 	// Initialze File System Factory
 	_fsFactory = new POSIXFilesystemFactory();
 
@@ -59,6 +65,12 @@ void OSystem_POSIX::init() {
 	OSystem_SDL::init();
 }
 
+uint32 OSystem_POSIX::getMicros() {
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	return (uint32)((curTime.tv_sec - _startSeconds) * 1000000 + curTime.tv_usec);
+}
+
 void OSystem_POSIX::initBackend() {
 	// Create the savefile manager
 	if (_savefileManager == 0)
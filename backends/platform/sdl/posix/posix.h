@@ -38,6 +38,8 @@ public:
 	virtual void init();
 	virtual void initBackend();
 
+	virtual uint32 getMicros();
+
 protected:
 	/**
 	 * Base string for creating the default path and filename for the
@@ -56,6 +58,9 @@ protected:
 	 */
 	Common::String _logFilePath;
 
+	/** The seconds of the time of day at init(), see getMicros() */
+	uint32 _startSeconds;
+
 	virtual Common::String getDefaultConfigFileName();
 
 	virtual Common::WriteStream *createLogFile();
@@ -31,19 +31,30 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/events.h"
+#include "common/system.h"
+#include "common/textconsole.h"
 #include "common/zlib.h"
 
 #ifndef _WIN32_WCE
 #include <errno.h>	// for removeSavefile()
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+DefaultSaveFileManager::DefaultSaveFileManager() : _asyncSourceRegistered(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath)
+	: _asyncSourceRegistered(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	// The manager stays registered as an event source: the event manager
+	// may already be gone, depending on the backend. The event dispatcher
+	// doesn't touch sources it doesn't own when it is destroyed.
+	flushAsyncSaves();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -55,6 +66,8 @@ void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 }
 
 Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &pattern) {
+	flushAsyncSaves();
+
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
 	if (getError().getCode() != Common::kNoError)
@@ -70,7 +83,9 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 
 	if (dir.listMatchingMembers(savefiles, search) > 0) {
 		for (Common::ArchiveMemberList::const_iterator file = savefiles.begin(); file != savefiles.end(); ++file) {
-			results.push_back((*file)->getName());
+			// Save indexes are no savegames of any engine
+			if (!isSaveIndexName((*file)->getName()))
+				results.push_back((*file)->getName());
 		}
 	}
 
@@ -78,6 +93,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	flushAsyncSaves();
+
 	// Ensure that the savepath is valid. If not, generate an appropriate error.
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
@@ -98,6 +115,8 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename) {
+	flushAsyncSaves();
+
 	// Ensure that the savepath is valid. If not, generate an appropriate error.
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
@@ -109,6 +128,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	Common::FSNode file = savePath.getChild(filename);
 
+	removeSaveIndex(savePath, filename);
+
 	// Open the file for saving
 	Common::WriteStream *sf = file.createWriteStream();
 
@@ -116,6 +137,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	flushAsyncSaves();
+
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
 	if (getError().getCode() != Common::kNoError)
@@ -126,6 +149,8 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 
 	Common::FSNode file = savePath.getChild(filename);
 
+	removeSaveIndex(savePath, filename);
+
 	// FIXME: remove does not exist on all systems. If your port fails to
 	// compile because of this, please let us know (scummvm-devel or Fingolfin).
 	// There is a nicely portable workaround, too: Make this method overloadable.
@@ -143,6 +168,131 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	}
 }
 
+void DefaultSaveFileManager::removeSaveIndex(const Common::FSNode &savePath, const Common::String &filename) {
+	const Common::String &target = ConfMan.getActiveDomainName();
+	if (target.empty())
+		return;
+
+	const Common::String indexName = getSaveIndexName(target);
+	if (filename.equalsIgnoreCase(indexName))
+		return;
+
+	Common::FSNode index = savePath.getChild(indexName);
+	if (index.exists())
+		remove(index.getPath().c_str());
+}
+
+void DefaultSaveFileManager::writeAsyncSave(const Common::String &name, byte *data, uint32 size, Common::SaveCallback *callback) {
+	Common::String savePathName = getSavePath();
+	checkPath(Common::FSNode(savePathName));
+	if (getError().getCode() != Common::kNoError) {
+		free(data);
+		finishAsyncSave(name, false, callback);
+		return;
+	}
+
+	// recreate FSNode since checkPath may have changed/created the directory
+	Common::FSNode savePath(savePathName);
+
+	AsyncSave save;
+	save.name = name;
+	save.file = savePath.getChild(name);
+	save.tempFile = savePath.getChild(name + ".tmp");
+	save.stream = Common::wrapCompressedWriteStream(save.tempFile.createWriteStream());
+	save.data = data;
+	save.size = size;
+	save.pos = 0;
+	save.success = false;
+	save.callback = callback;
+
+	removeSaveIndex(savePath, name);
+
+	if (!save.stream) {
+		free(data);
+		finishAsyncSave(name, false, callback);
+		return;
+	}
+
+	_asyncSaves.push_back(save);
+
+	// The savefile is written a piece at a time whenever events are polled
+	if (!_asyncSourceRegistered) {
+		Common::EventManager *eventMan = g_system->getEventManager();
+		if (eventMan) {
+			eventMan->getEventDispatcher()->registerSource(this, false);
+			_asyncSourceRegistered = true;
+		} else {
+			flushAsyncSaves();
+		}
+	}
+}
+
+void DefaultSaveFileManager::flushAsyncSaves() {
+	processAsyncSaves(0xFFFFFFFF);
+}
+
+bool DefaultSaveFileManager::pollEvent(Common::Event &event) {
+	if (!_asyncSaves.empty())
+		processAsyncSaves(kAsyncSaveChunkSize);
+
+	return false;
+}
+
+void DefaultSaveFileManager::processAsyncSaves(uint32 maxBytes) {
+	Common::List<AsyncSave> done;
+
+	while (!_asyncSaves.empty()) {
+		AsyncSave &save = _asyncSaves.front();
+
+		const uint32 length = MIN(save.size - save.pos, maxBytes);
+		save.stream->write(save.data + save.pos, length);
+		save.pos += length;
+		maxBytes -= length;
+
+		// Give up on the savefile after the first error
+		if (save.stream->err())
+			save.pos = save.size;
+
+		if (save.pos < save.size)
+			break;
+
+		save.success = commitAsyncSave(save);
+		done.push_back(save);
+		_asyncSaves.pop_front();
+	}
+
+	// The callbacks are called once the savefiles are off the queue, so
+	// that they may use the savefile manager
+	for (Common::List<AsyncSave>::iterator i = done.begin(); i != done.end(); ++i)
+		finishAsyncSave(i->name, i->success, i->callback);
+}
+
+bool DefaultSaveFileManager::commitAsyncSave(AsyncSave &save) {
+	save.stream->finalize();
+	bool success = !save.stream->err();
+
+	delete save.stream;
+	save.stream = 0;
+	free(save.data);
+	save.data = 0;
+
+	const Common::String tempPath = save.tempFile.getPath();
+	const Common::String path = save.file.getPath();
+
+	if (success && rename(tempPath.c_str(), path.c_str()) != 0) {
+		// Not all systems replace an existing file on rename
+		remove(path.c_str());
+		success = (rename(tempPath.c_str(), path.c_str()) == 0);
+	}
+
+	if (!success) {
+		warning("Writing the savefile '%s' failed", save.name.c_str());
+		remove(tempPath.c_str());
+	}
+
+	return success;
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
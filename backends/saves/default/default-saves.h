@@ -27,19 +27,31 @@
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/fs.h"
+#include "common/events.h"
+#include "common/list.h"
 
 /**
  * Provides a default savefile manager implementation for common platforms.
+ *
+ * Savefiles opened with openForSavingAsync() are written on the main thread
+ * while the engine polls for events: the manager registers itself as an
+ * event source, which never returns an event, and compresses and writes a
+ * piece of the queued savefiles each time it is polled.
  */
-class DefaultSaveFileManager : public Common::SaveFileManager {
+class DefaultSaveFileManager : public Common::SaveFileManager, public Common::EventSource {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	virtual ~DefaultSaveFileManager();
 
 	virtual Common::StringArray listSavefiles(const Common::String &pattern);
+	virtual bool supportsSaveIndex() const { return true; }
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename);
 	virtual bool removeSavefile(const Common::String &filename);
+	virtual void flushAsyncSaves();
+
+	virtual bool pollEvent(Common::Event &event);
 
 protected:
 	/**
@@ -54,6 +66,45 @@ protected:
 	 * Sets the internal error and error message accordingly.
 	 */
 	virtual void checkPath(const Common::FSNode &dir);
+
+	/**
+	 * Removes the save index of the running game (see getSaveIndexName()),
+	 * unless the given savefile is that save index.
+	 */
+	void removeSaveIndex(const Common::FSNode &savePath, const Common::String &filename);
+
+	/**
+	 * Queues the savefile to be compressed and written into a temporary
+	 * file, a piece at a time while events are polled. Once complete, the
+	 * temporary file replaces the savefile.
+	 */
+	virtual void writeAsyncSave(const Common::String &name, byte *data, uint32 size, Common::SaveCallback *callback);
+
+private:
+	enum {
+		kAsyncSaveChunkSize = 32 * 1024 ///< Bytes written per pollEvent() call
+	};
+
+	struct AsyncSave {
+		Common::String name;
+		Common::FSNode file;
+		Common::FSNode tempFile;
+		Common::WriteStream *stream; ///< Compresses into tempFile
+		byte *data;
+		uint32 size;
+		uint32 pos;
+		bool success;
+		Common::SaveCallback *callback;
+	};
+
+	Common::List<AsyncSave> _asyncSaves; ///< Queue of savefiles to be written
+	bool _asyncSourceRegistered;         ///< Whether the manager is registered as an event source
+
+	/** Write up to the given amount of data of the queued savefiles. */
+	void processAsyncSaves(uint32 maxBytes);
+
+	/** Replace the savefile by the completed temporary file. */
+	static bool commitAsyncSave(AsyncSave &save);
 };
 
 #endif
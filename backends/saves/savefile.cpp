@@ -26,6 +26,105 @@
 
 namespace Common {
 
+/**
+ * A savefile opened with SaveFileManager::openForSavingAsync(). It keeps
+ * the data in memory, and hands it to the savefile manager when finalized.
+ */
+class AsyncOutSaveFile : public OutSaveFile {
+public:
+	AsyncOutSaveFile(SaveFileManager *manager, const String &name, SaveCallback *callback)
+		: _manager(manager), _name(name), _callback(callback), _data(0), _size(0), _capacity(0), _err(false) {
+	}
+
+	~AsyncOutSaveFile() {
+		finalize();
+		free(_data);
+		delete _callback;
+	}
+
+	bool err() const { return _err; }
+	void clearErr() { _err = false; }
+
+	uint32 write(const void *dataPtr, uint32 dataSize) {
+		if (!_manager) {
+			// Already finalized
+			_err = true;
+			return 0;
+		}
+
+		if (_size + dataSize > _capacity) {
+			// Grow geometrically, as savegames are written in lots of
+			// small pieces
+			const uint32 capacity = MAX<uint32>(MAX<uint32>(_capacity * 2, 64 * 1024), _size + dataSize);
+			byte *data = (byte *)realloc(_data, capacity);
+			if (!data) {
+				_err = true;
+				return 0;
+			}
+
+			_data = data;
+			_capacity = capacity;
+		}
+
+		memcpy(_data + _size, dataPtr, dataSize);
+		_size += dataSize;
+		return dataSize;
+	}
+
+	void finalize() {
+		if (!_manager)
+			return;
+
+		SaveFileManager *manager = _manager;
+		_manager = 0;
+
+		if (_err) {
+			SaveFileManager::finishAsyncSave(_name, false, _callback);
+		} else {
+			manager->writeAsyncSave(_name, _data, _size, _callback);
+			_data = 0;
+		}
+		_callback = 0;
+	}
+
+private:
+	SaveFileManager *_manager; ///< 0 once finalized
+	String _name;
+	SaveCallback *_callback;
+
+	byte *_data;
+	uint32 _size;
+	uint32 _capacity;
+	bool _err;
+};
+
+OutSaveFile *SaveFileManager::openForSavingAsync(const String &name, SaveCallback *callback) {
+	return new AsyncOutSaveFile(this, name, callback);
+}
+
+void SaveFileManager::writeAsyncSave(const String &name, byte *data, uint32 size, SaveCallback *callback) {
+	OutSaveFile *outFile = openForSaving(name);
+	bool success = false;
+
+	if (outFile) {
+		outFile->write(data, size);
+		outFile->finalize();
+
+		success = !outFile->err();
+		delete outFile;
+	}
+
+	free(data);
+	finishAsyncSave(name, success, callback);
+}
+
+void SaveFileManager::finishAsyncSave(const String &name, bool success, SaveCallback *callback) {
+	if (callback && callback->isValid())
+		(*callback)(name, success);
+
+	delete callback;
+}
+
 bool SaveFileManager::copySavefile(const String &oldFilename, const String &newFilename) {
 	InSaveFile *inFile = 0;
 	OutSaveFile *outFile = 0;
@@ -71,6 +170,20 @@ bool SaveFileManager::renameSavefile(const String &oldFilename, const String &ne
 	return removeSavefile(oldFilename);
 }
 
+// Hidden on systems which hide files starting with a dot
+static const char *const kSaveIndexPrefix = ".saveindex-";
+
+String SaveFileManager::getSaveIndexName(const String &target) {
+	String name = target;
+	name.toLowercase();
+
+	return kSaveIndexPrefix + name;
+}
+
+bool SaveFileManager::isSaveIndexName(const String &name) {
+	return name.hasPrefix(kSaveIndexPrefix);
+}
+
 String SaveFileManager::popErrorDesc() {
 	String err = _errorDesc;
 	clearError();
@@ -21,91 +21,164 @@
 
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
+#include "common/algorithm.h"
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/system.h"
 
+enum {
+	// Timers which fall further behind than this skip the calls they
+	// missed instead of catching up on all of them at once, e.g. after
+	// the process was suspended. In microseconds.
+	kMaxTimerLateness = 1000000
+};
+
 struct TimerSlot {
 	Common::TimerManager::TimerProc callback;
 	void *refCon;
 	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
-
-	TimerSlot *next;
+	uint32 nextFireTime;	// in microseconds
+	uint32 sequence;	// keeps timers due at the same time in the order they were scheduled
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+/** Returns whether slot a is due before slot b. */
+static bool isDueBefore(const TimerSlot *a, const TimerSlot *b) {
+	const int32 diff = (int32)(a->nextFireTime - b->nextFireTime);
+	if (diff != 0)
+		return diff < 0;
+	return (int32)(a->sequence - b->sequence) < 0;
+}
+
+void DefaultTimerManager::pushSlot(TimerSlot *slot) {
+	slot->sequence = _nextSequence++;
+
+	uint i = _heap.size();
+	_heap.push_back(slot);
+
+	while (i > 0) {
+		const uint parent = (i - 1) / 2;
+		if (!isDueBefore(slot, _heap[parent]))
+			break;
+		_heap[i] = _heap[parent];
+		i = parent;
+	}
+
+	_heap[i] = slot;
+}
+
+TimerSlot *DefaultTimerManager::popSlot() {
+	TimerSlot *top = _heap.front();
+	TimerSlot *last = _heap.back();
+	_heap.pop_back();
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = 0;
+	const uint size = _heap.size();
+	if (!size)
+		return top;
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
+	uint i = 0;
 	while (true) {
-		assert(slot);
-		if (slot->next == 0 || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+		uint child = 2 * i + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && isDueBefore(_heap[child + 1], _heap[child]))
+			child++;
+		if (!isDueBefore(_heap[child], last))
+			break;
+		_heap[i] = _heap[child];
+		i = child;
 	}
+
+	_heap[i] = last;
+	return top;
 }
 
+static void addMicros(uint32 &millis, uint32 &rest, uint32 micros) {
+	rest += micros;
+	millis += rest / 1000;
+	rest %= 1000;
+}
 
 DefaultTimerManager::DefaultTimerManager() :
 	_timerHandler(0),
-	_head(0) {
-
-	_head = new TimerSlot();
-	memset(_head, 0, sizeof(TimerSlot));
+	_nextSequence(0),
+	_lastTime(ProfileMan.getMicros()) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
-	}
-	_head = 0;
+	for (uint i = 0; i < _heap.size(); ++i)
+		delete _heap[i];
+	_heap.clear();
 }
 
 void DefaultTimerManager::handler() {
-	Common::StackLock lock(_mutex);
+	// Keeps removeTimerProc() from returning while a timer proc runs
+	Common::StackLock callbackLock(_callbackMutex);
+
+	while (true) {
+		TimerProc callback;
+		void *refCon;
+		Common::String id;
+		uint32 lateness;
+		uint32 skipped = 0;
+
+		{
+			Common::StackLock lock(_mutex);
+
+			const uint32 curTime = ProfileMan.getMicros();
+
+			// The clock is supposed to be monotonic, but the one we have may
+			// jump back, e.g. when the system time is adjusted. Move all
+			// timers along with it.
+			const int32 elapsed = (int32)(curTime - _lastTime);
+			if (elapsed < 0) {
+				for (uint i = 0; i < _heap.size(); ++i)
+					_heap[i]->nextFireTime += elapsed;
+			}
+			_lastTime = curTime;
 
-	const uint32 curTime = g_system->getMillis();
-
-	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
-		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
+			if (_heap.empty() || (int32)(curTime - _heap.front()->nextFireTime) < 0)
+				break;
+
+			TimerSlot *slot = popSlot();
+			lateness = curTime - slot->nextFireTime;
+
+			// Update the fire time and put the slot back into the queue
+			assert(slot->interval > 0);
+			slot->nextFireTime += slot->interval;
+
+			if (lateness > kMaxTimerLateness) {
+				skipped = lateness / slot->interval;
+				slot->nextFireTime += skipped * slot->interval;
+			}
+
+			pushSlot(slot);
+
+			callback = slot->callback;
+			refCon = slot->refCon;
+			id = slot->id;
 		}
-		insertPrioQueue(_head, slot);
 
 		// Invoke the timer callback
-		assert(slot->callback);
-		slot->callback(slot->refCon);
+		assert(callback);
+		const uint32 startTime = ProfileMan.getMicros();
+		callback(refCon);
+		const uint32 runtime = ProfileMan.getMicros() - startTime;
+
+		{
+			Common::StackLock lock(_mutex);
 
-		// Look at the next scheduled timer
-		slot = _head->next;
+			TimerStats &stats = _stats[id];
+			stats.calls++;
+			stats.skipped += skipped;
+			addMicros(stats.totalLateness, stats.latenessRest, lateness);
+			stats.maxLateness = MAX(stats.maxLateness, lateness);
+			addMicros(stats.totalRuntime, stats.runtimeRest, runtime);
+			stats.maxRuntime = MAX(stats.maxRuntime, runtime);
+		}
 	}
 }
 
@@ -132,9 +205,7 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = 0;
+	slot->nextFireTime = ProfileMan.getMicros() + interval;
 
 	// FIXME: It seems we do allow the client to add one callback multiple times over here,
 	// but "removeTimerProc" will remove *all* added instances. We should either prevent
@@ -142,24 +213,24 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	// a specific timer proc entry.
 	// Probably we can safely just allow a single addition of a specific function once
 	// and just update our Timer documentation accordingly.
-	insertPrioQueue(_head, slot);
+	pushSlot(slot);
 
 	return true;
 }
 
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
+	// Wait for the timer procs to finish, unless we are called from one
+	Common::StackLock callbackLock(_callbackMutex);
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
+	Common::Array<TimerSlot *> slots = _heap;
+	_heap.clear();
 
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
-		}
+	for (uint i = 0; i < slots.size(); ++i) {
+		if (slots[i]->callback == callback)
+			delete slots[i];
+		else
+			pushSlot(slots[i]);
 	}
 
 	// We need to remove all names referencing the timer proc here.
@@ -179,3 +250,35 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 			_callbacks.erase(i);
 	}
 }
+
+Common::Array<Common::String> DefaultTimerManager::formatStats() {
+	Common::StackLock lock(_mutex);
+
+	Common::Array<Common::String> ids;
+	for (TimerStatsMap::const_iterator i = _stats.begin(); i != _stats.end(); ++i)
+		ids.push_back(i->_key);
+	Common::sort(ids.begin(), ids.end());
+
+	Common::Array<Common::String> lines;
+	lines.push_back(Common::String::format("%-24s %8s %7s %10s %10s %10s %10s", "id", "calls", "skipped",
+		"avg late", "max late", "avg run", "max run"));
+
+	for (uint i = 0; i < ids.size(); ++i) {
+		const TimerStats &stats = _stats[ids[i]];
+		const uint32 calls = MAX<uint32>(stats.calls, 1);
+
+		const uint32 avgLateness = (uint32)((stats.totalLateness * 1000.0 + stats.latenessRest) / calls);
+		const uint32 avgRuntime = (uint32)((stats.totalRuntime * 1000.0 + stats.runtimeRest) / calls);
+
+		lines.push_back(Common::String::format("%-24s %8u %7u %8uus %8uus %8uus %8uus", ids[i].c_str(),
+			stats.calls, stats.skipped, avgLateness, stats.maxLateness, avgRuntime, stats.maxRuntime));
+	}
+
+	return lines;
+}
+
+void DefaultTimerManager::resetStats() {
+	Common::StackLock lock(_mutex);
+
+	_stats.clear();
+}
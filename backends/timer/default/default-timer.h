@@ -23,20 +23,55 @@
 #define BACKENDS_TIMER_DEFAULT_H
 
 #include "common/str.h"
+#include "common/array.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
 #include "common/mutex.h"
 
 struct TimerSlot;
 
+/**
+ * Timer manager which runs the timer procs from handler(), which the
+ * backend calls at regular intervals.
+ *
+ * The installed timers are kept in a binary heap ordered by the time they
+ * are due next, measured with a microsecond clock. The timer procs run
+ * without the lock protecting the timer list held, so installing timers
+ * doesn't have to wait for a running timer proc. Removing a timer still
+ * does, so that it can't be running anymore once removeTimerProc()
+ * returns.
+ */
 class DefaultTimerManager : public Common::TimerManager {
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
-	Common::Mutex _mutex;
+	struct TimerStats {
+		uint32 calls;
+		uint32 skipped;       ///< Number of calls dropped because the timer fell too far behind
+		uint32 totalLateness; ///< in milliseconds
+		uint32 maxLateness;   ///< in microseconds
+		uint32 totalRuntime;  ///< in milliseconds
+		uint32 maxRuntime;    ///< in microseconds
+		uint32 latenessRest;  ///< microseconds not yet added to totalLateness
+		uint32 runtimeRest;   ///< microseconds not yet added to totalRuntime
+
+		TimerStats() : calls(0), skipped(0), totalLateness(0), maxLateness(0),
+			totalRuntime(0), maxRuntime(0), latenessRest(0), runtimeRest(0) {}
+	};
+
+	typedef Common::HashMap<Common::String, TimerStats, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerStatsMap;
+
+	Common::Mutex _mutex;         ///< Protects the timer list and the statistics
+	Common::Mutex _callbackMutex; ///< Held while the timer procs run
 	void *_timerHandler;
-	TimerSlot *_head;
+	Common::Array<TimerSlot *> _heap;
 	TimerSlotMap _callbacks;
+	TimerStatsMap _stats;
+	uint32 _nextSequence;
+	uint32 _lastTime;
+
+	void pushSlot(TimerSlot *slot);
+	TimerSlot *popSlot();
 
 public:
 	DefaultTimerManager();
@@ -44,6 +79,9 @@ public:
 	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
 	virtual void removeTimerProc(TimerProc proc);
 
+	virtual Common::Array<Common::String> formatStats();
+	virtual void resetStats();
+
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
 	 */
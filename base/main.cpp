@@ -44,6 +44,7 @@
 #include "common/events.h"
 #include "common/EventRecorder.h"
 #include "common/fs.h"
+#include "common/savefile.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
@@ -215,6 +216,9 @@ static Common::Error runGame(const EnginePlugin *plugin, OSystem &system, const
 	// Free up memory
 	delete engine;
 
+	// Finish writing the savefiles the engine saved in the background
+	system.getSavefileManager()->flushAsyncSaves();
+
 	// We clear all debug levels again even though the engine should do it
 	DebugMan.clearAllDebugChannels();
 
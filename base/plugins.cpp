@@ -25,6 +25,9 @@
 #include "common/func.h"
 #include "common/debug.h"
 #include "common/config-manager.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/tokenizer.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
@@ -349,6 +352,8 @@ void PluginManager::addPluginProvider(PluginProvider *pp) {
  * This should only be called once by main()
  **/
 void PluginManagerUncached::init() {
+	uint32 startTime = g_system->getMillis();
+
 	unloadAllPlugins();
 	_allEnginePlugins.clear();
 
@@ -379,6 +384,10 @@ void PluginManagerUncached::init() {
 			}
  		}
  	}
+
+	updatePluginIndex();
+
+	debug(1, "Found %d engine plugins in %d ms", _allEnginePlugins.size(), g_system->getMillis() - startTime);
 }
 
 /**
@@ -397,6 +406,12 @@ bool PluginManagerUncached::loadPluginFromGameId(const Common::String &gameId) {
 			}
 		}
 	}
+
+	// Fall back to the plugin index, which knows the game ids of all plugins
+	Common::StringMap::const_iterator it = _pluginIndex.find(gameId);
+	if (it != _pluginIndex.end())
+		return loadPluginByFileName(it->_value);
+
 	return false;
 }
 
@@ -543,6 +558,70 @@ void PluginManager::addToPluginsInMemList(Plugin *plugin) {
 
 #include "engines/metaengine.h"
 
+/**
+ * Keep an index of the game ids supported by each engine plugin file in the
+ * ConfigManager domain 'plugin_index', so that the plugin for a game can be
+ * found without loading all plugins. Every entry starts with the size of
+ * the plugin file, and only the plugins which are new or whose size changed
+ * are loaded to update their entry.
+ **/
+void PluginManagerUncached::updatePluginIndex() {
+	uint32 startTime = g_system->getMillis();
+	int scanned = 0;
+
+	if (!ConfMan.hasMiscDomain("plugin_index"))
+		ConfMan.addMiscDomain("plugin_index");
+
+	Common::ConfigManager::Domain *domain = ConfMan.getDomain("plugin_index");
+	assert(domain);
+
+	Common::StringMap index;
+	_pluginIndex.clear();
+
+	for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		if (!(*p)->getFileName())
+			continue;
+
+		Common::String filename = (*p)->getFileName();
+
+		Common::SeekableReadStream *file = Common::FSNode(filename).createReadStream();
+		if (!file)
+			continue;
+		Common::String entry = Common::String::format("%d", file->size());
+		delete file;
+
+		if (domain->contains(filename) && Common::StringTokenizer((*domain)[filename]).nextToken() == entry) {
+			entry = (*domain)[filename];
+		} else if ((*p)->loadPlugin()) {
+			GameList games = (*(EnginePlugin *)*p)->getSupportedGames();
+			for (GameList::const_iterator g = games.begin(); g != games.end(); ++g)
+				entry += " " + g->gameid();
+
+			(*p)->unloadPlugin();
+			scanned++;
+		} else {
+			continue;
+		}
+
+		index[filename] = entry;
+
+		Common::StringTokenizer tokenizer(entry);
+		tokenizer.nextToken();	// skip the file size
+		while (!tokenizer.empty())
+			_pluginIndex[tokenizer.nextToken()] = filename;
+	}
+
+	if (scanned || (index.size() != domain->size())) {
+		domain->clear();
+		for (Common::StringMap::const_iterator i = index.begin(); i != index.end(); ++i)
+			(*domain)[i->_key] = i->_value;
+
+		ConfMan.flushToDisk();
+	}
+
+	debug(1, "Plugin index: %d plugins loaded to update the index in %d ms", scanned, g_system->getMillis() - startTime);
+}
+
 namespace Common {
 DECLARE_SINGLETON(EngineManager);
 }
@@ -25,6 +25,7 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hash-str.h"
 #include "common/str.h"
 #include "backends/plugins/elf/version.h"
 
@@ -348,8 +349,12 @@ protected:
 	PluginList _allEnginePlugins;
 	PluginList::iterator _currentPlugin;
 
+	/** Maps the game ids supported by the engine plugins to the plugin files */
+	Common::StringMap _pluginIndex;
+
 	PluginManagerUncached() {}
 	bool loadPluginByFileName(const Common::String &filename);
+	void updatePluginIndex();
 
 public:
 	virtual void init();
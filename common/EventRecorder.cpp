@@ -22,6 +22,7 @@
 
 #include "common/EventRecorder.h"
 
+#include "common/algorithm.h"
 #include "common/bufferedstream.h"
 #include "common/config-manager.h"
 #include "common/random.h"
@@ -130,6 +131,12 @@ EventRecorder::EventRecorder() {
 	_lastEventMillis = 0;
 
 	_recordMode = kPassthrough;
+
+	_benchmark = false;
+	_lastFrameMillis = 0;
+	_benchmarkStartMillis = 0;
+	_frameHash = 0;
+	_frameHashFile = NULL;
 }
 
 EventRecorder::~EventRecorder() {
@@ -149,6 +156,11 @@ void EventRecorder::init() {
 		if (recordModeString.compareToIgnoreCase("playback") == 0) {
 			_recordMode = kRecorderPlayback;
 			debug(3, "EventRecorder: playback");
+		} else if (recordModeString.compareToIgnoreCase("benchmark") == 0) {
+			// Playback without any delays, measuring and hashing each frame
+			_recordMode = kRecorderPlayback;
+			_benchmark = true;
+			debug(3, "EventRecorder: benchmark");
 		} else {
 			_recordMode = kPassthrough;
 			debug(3, "EventRecorder: passthrough");
@@ -167,6 +179,10 @@ void EventRecorder::init() {
 	if (_recordTimeFileName.empty()) {
 		_recordTimeFileName = "record.time";
 	}
+	_frameHashFileName = ConfMan.get("record_hash_file_name");
+	if (_frameHashFileName.empty()) {
+		_frameHashFileName = "record.hash";
+	}
 
 	// recorder stuff
 	if (_recordMode == kRecorderRecord) {
@@ -226,6 +242,16 @@ void EventRecorder::init() {
 		_hasPlaybackEvent = false;
 	}
 
+	if (_recordMode != kRecorderPlayback)
+		_benchmark = false;
+
+	if (_benchmark) {
+		_frameHash = 0x811C9DC5;
+		_frameTimes.clear();
+		_frameHashFile = g_system->getSavefileManager()->openForSaving(_frameHashFileName);
+		_benchmarkStartMillis = _lastFrameMillis = getRealMillis();
+	}
+
 	g_system->getEventManager()->getEventDispatcher()->registerSource(this, false);
 	g_system->getEventManager()->getEventDispatcher()->registerObserver(this, EventManager::kEventRecorderPriority, false, true);
 }
@@ -236,6 +262,18 @@ void EventRecorder::deinit() {
 	g_system->getEventManager()->getEventDispatcher()->unregisterSource(this);
 	g_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
 
+	if (_benchmark) {
+		printBenchmarkReport();
+
+		if (_frameHashFile) {
+			_frameHashFile->finalize();
+			delete _frameHashFile;
+			_frameHashFile = NULL;
+		}
+
+		_benchmark = false;
+	}
+
 	g_system->lockMutex(_timeMutex);
 	g_system->lockMutex(_recorderMutex);
 	_recordMode = kPassthrough;
@@ -325,7 +363,7 @@ void EventRecorder::processMillis(uint32 &millis) {
 		if (_recordTimeCount > _playbackTimeCount) {
 			d = readTime(_playbackTimeFile);
 
-			while ((_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
+			while (!_benchmark && (_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
 				_recordMode = kPassthrough;
 				g_system->delayMillis(50);
 				millis = g_system->getMillis();
@@ -343,6 +381,10 @@ void EventRecorder::processMillis(uint32 &millis) {
 
 bool EventRecorder::processDelayMillis(uint &msecs) {
 	if (_recordMode == kRecorderPlayback) {
+		// Run as fast as possible when benchmarking
+		if (_benchmark)
+			return true;
+
 		_recordMode = kPassthrough;
 
 		uint32 millis = g_system->getMillis();
@@ -358,6 +400,65 @@ bool EventRecorder::processDelayMillis(uint &msecs) {
 	return false;
 }
 
+void EventRecorder::processScreenUpdate(const byte *pixels, uint pitch, uint width, uint height, uint bytesPerPixel, const byte *palette) {
+	if (!_benchmark)
+		return;
+
+	// FNV-1a hash of the visible screen area and palette
+	uint32 hash = 0x811C9DC5;
+	const uint lineSize = width * bytesPerPixel;
+
+	for (uint y = 0; y < height && pixels; ++y) {
+		const byte *line = pixels + y * pitch;
+		for (uint x = 0; x < lineSize; ++x)
+			hash = (hash ^ line[x]) * 0x01000193;
+	}
+
+	if (palette) {
+		for (uint i = 0; i < 256 * 3; ++i)
+			hash = (hash ^ palette[i]) * 0x01000193;
+	}
+
+	_frameHash = (_frameHash ^ hash) * 0x01000193;
+	if (_frameHashFile)
+		_frameHashFile->writeUint32LE(hash);
+
+	const uint32 millis = getRealMillis();
+	_frameTimes.push_back(millis - _lastFrameMillis);
+	_lastFrameMillis = millis;
+}
+
+uint32 EventRecorder::getRealMillis() {
+	// Temporarily leave playback mode, so that the backend reports the
+	// real time instead of the recorded one
+	StackLock lock(_timeMutex);
+	const RecordMode mode = _recordMode;
+
+	_recordMode = kPassthrough;
+	const uint32 millis = g_system->getMillis();
+	_recordMode = mode;
+
+	return millis;
+}
+
+void EventRecorder::printBenchmarkReport() {
+	const uint32 totalMillis = getRealMillis() - _benchmarkStartMillis;
+	const uint frames = _frameTimes.size();
+
+	debug("EventRecorder: benchmark of '%s': %d frames in %d ms, frame hash %08x",
+	      ConfMan.getActiveDomainName().c_str(), frames, totalMillis, _frameHash);
+
+	if (!frames)
+		return;
+
+	Array<uint32> sorted = _frameTimes;
+	sort(sorted.begin(), sorted.end());
+
+	debug("EventRecorder: frame time (ms) min %d, p50 %d, p90 %d, p99 %d, max %d",
+	      sorted[0], sorted[(frames - 1) * 50 / 100], sorted[(frames - 1) * 90 / 100],
+	      sorted[(frames - 1) * 99 / 100], sorted[frames - 1]);
+}
+
 bool EventRecorder::notifyEvent(const Event &ev) {
 	if (_recordMode != kRecorderRecord)
 		return false;
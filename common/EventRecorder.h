@@ -59,6 +59,22 @@ public:
 	/** TODO: Add documentation, this is only used by the backend */
 	bool processDelayMillis(uint &msecs);
 
+	/**
+	 * Notify the recorder that the backend presented a new frame.
+	 *
+	 * In benchmark mode (record_mode "benchmark") the frame is hashed for
+	 * regression checks and the real time spent on it is measured. This
+	 * is only used by the backend.
+	 *
+	 * @param pixels		the screen contents
+	 * @param pitch			the number of bytes per screen line
+	 * @param width			the screen width in pixels
+	 * @param height		the screen height in pixels
+	 * @param bytesPerPixel	the number of bytes per pixel
+	 * @param palette		the current palette for CLUT8 screens, or 0
+	 */
+	void processScreenUpdate(const byte *pixels, uint pitch, uint width, uint height, uint bytesPerPixel, const byte *palette);
+
 private:
 	bool notifyEvent(const Event &ev);
 	bool notifyPoll();
@@ -94,6 +110,21 @@ private:
 	volatile uint32 _eventCount;
 	volatile uint32 _lastEventCount;
 
+	/**
+	 * Set when playing back as fast as possible: delays are skipped,
+	 * every frame is hashed and the real frame times are measured.
+	 */
+	bool _benchmark;
+	uint32 _lastFrameMillis;
+	uint32 _benchmarkStartMillis;
+	uint32 _frameHash;
+	Array<uint32> _frameTimes;
+	WriteStream *_frameHashFile;
+	String _frameHashFileName;
+
+	uint32 getRealMillis();
+	void printBenchmarkReport();
+
 	enum RecordMode {
 		kPassthrough = 0,
 		kRecorderRecord = 1,
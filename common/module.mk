@@ -18,6 +18,7 @@ MODULE_OBJS := \
 	memorypool.o \
 	md5.o \
 	mutex.o \
+	profiler.o \
 	quicktime.o \
 	random.o \
 	rational.o \
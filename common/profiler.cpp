@@ -0,0 +1,158 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// We use gettimeofday, when available, for sub millisecond timings
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+#include "common/profiler.h"
+#include "common/file.h"
+#include "common/system.h"
+
+#if defined(POSIX)
+#include <sys/time.h>
+#endif
+
+namespace Common {
+
+DECLARE_SINGLETON(ProfileManager);
+
+namespace {
+
+/** Like StackLock, but does nothing when there is no mutex. */
+class CounterLock {
+public:
+	CounterLock(Mutex *mutex) : _mutex(mutex) {
+		if (_mutex)
+			_mutex->lock();
+	}
+
+	~CounterLock() {
+		if (_mutex)
+			_mutex->unlock();
+	}
+
+private:
+	Mutex *_mutex;
+};
+
+} // End of anonymous namespace
+
+ProfileManager::ProfileManager() : _mutex(g_system ? new Mutex() : 0) {
+}
+
+ProfileManager::~ProfileManager() {
+	for (uint i = 0; i < _counters.size(); ++i)
+		delete _counters[i];
+	delete _mutex;
+}
+
+ProfileManager::Counter *ProfileManager::getCounter(const char *name) {
+	CounterLock lock(_mutex);
+
+	for (uint i = 0; i < _counters.size(); ++i) {
+		if (_counters[i]->name == name)
+			return _counters[i];
+	}
+
+	Counter *counter = new Counter(name);
+	_counters.push_back(counter);
+	return counter;
+}
+
+void ProfileManager::addSample(Counter *counter, uint32 micros) {
+	CounterLock lock(_mutex);
+
+	counter->window[counter->calls % kWindowSize] = micros;
+	counter->calls++;
+	counter->totalMicros += micros;
+	counter->totalMillis += counter->totalMicros / 1000;
+	counter->totalMicros %= 1000;
+}
+
+uint32 ProfileManager::getMicros() const {
+#if defined(POSIX)
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	return (uint32)(curTime.tv_sec * 1000000 + curTime.tv_usec);
+#else
+	return g_system->getMicros();
+#endif
+}
+
+void ProfileManager::resetCounters() {
+	CounterLock lock(_mutex);
+
+	for (uint i = 0; i < _counters.size(); ++i) {
+		Counter *counter = _counters[i];
+		counter->calls = 0;
+		counter->totalMillis = 0;
+		counter->totalMicros = 0;
+		for (int j = 0; j < kWindowSize; ++j)
+			counter->window[j] = 0;
+	}
+}
+
+Array<String> ProfileManager::formatCounters() {
+	CounterLock lock(_mutex);
+	Array<String> lines;
+
+	lines.push_back(String::format("%-24s %10s %10s %10s %10s %12s", "counter", "min (us)", "avg (us)", "max (us)", "calls", "total (ms)"));
+
+	for (uint i = 0; i < _counters.size(); ++i) {
+		const Counter *counter = _counters[i];
+		const uint32 samples = MIN<uint32>(counter->calls, kWindowSize);
+
+		uint32 min = 0, max = 0;
+		double sum = 0;
+		for (uint32 j = 0; j < samples; ++j) {
+			const uint32 micros = counter->window[j];
+			if (j == 0 || micros < min)
+				min = micros;
+			if (micros > max)
+				max = micros;
+			sum += micros;
+		}
+
+		lines.push_back(String::format("%-24s %10u %10u %10u %10u %12u", counter->name.c_str(),
+		                               min, samples ? (uint32)(sum / samples) : 0, max,
+		                               counter->calls, counter->totalMillis));
+	}
+
+	return lines;
+}
+
+bool ProfileManager::dumpCounters(const String &filename) {
+	DumpFile file;
+	if (!file.open(filename))
+		return false;
+
+	const Array<String> lines = formatCounters();
+	for (uint i = 0; i < lines.size(); ++i) {
+		file.writeString(lines[i]);
+		file.writeByte('\n');
+	}
+
+	file.finalize();
+	return !file.err();
+}
+
+} // End of namespace Common
@@ -0,0 +1,146 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * Registry of named timing counters for hot code paths.
+ *
+ * Code is instrumented with the PROFILE_SCOPE macro, which measures the
+ * time spent until the end of the enclosing scope. The macro expands to
+ * nothing unless ScummVM is configured with --enable-perf-counters, so
+ * the instrumentation costs nothing in regular builds. Unlike
+ * --enable-profiling, this does not build with gprof instrumentation.
+ *
+ * For every counter the durations of the last kWindowSize samples are
+ * kept, from which the debugger "perf" command prints min/avg/max.
+ */
+class ProfileManager : public Singleton<ProfileManager> {
+public:
+	enum {
+		kWindowSize = 256
+	};
+
+	struct Counter {
+		Counter(const String &n) : name(n), calls(0), totalMillis(0), totalMicros(0) {
+			for (int i = 0; i < kWindowSize; ++i)
+				window[i] = 0;
+		}
+
+		String name;
+
+		/** Number of samples since the counter was created or reset */
+		uint32 calls;
+		/** Total time of all samples, split into milliseconds and the remaining microseconds */
+		uint32 totalMillis;
+		uint32 totalMicros;
+		/** Durations of the most recent samples in microseconds */
+		uint32 window[kWindowSize];
+	};
+
+	/**
+	 * Returns the counter with the given name, creating it if necessary.
+	 * The returned pointer stays valid for the lifetime of the manager.
+	 */
+	Counter *getCounter(const char *name);
+
+	/**
+	 * Adds a sample of the given duration (in microseconds) to a counter.
+	 * Counters may be used from several threads, e.g. by the mixer.
+	 */
+	void addSample(Counter *counter, uint32 micros);
+
+	/** Returns a monotonic timestamp in microseconds. */
+	uint32 getMicros() const;
+
+	/** Resets the statistics of all counters. */
+	void resetCounters();
+
+	/**
+	 * Formats the statistics of all counters, one line per counter.
+	 * The lines contain the rolling min/avg/max over the most recent
+	 * samples, followed by the total number of samples and time.
+	 */
+	Array<String> formatCounters();
+
+	/** Writes the formatted statistics of all counters to a file. */
+	bool dumpCounters(const String &filename);
+
+private:
+	Array<Counter *> _counters;
+
+	/**
+	 * Guards the counters. It is only created when a backend exists, as
+	 * Mutex requires one; without a backend, e.g. in the unit tests, there
+	 * is only a single thread and the counters are not locked.
+	 */
+	Mutex *_mutex;
+
+	friend class Singleton<SingletonBaseType>;
+	ProfileManager();
+	~ProfileManager();
+};
+
+/**
+ * Measures the time from its construction to its destruction and adds
+ * it to a counter of the ProfileManager. Use PROFILE_SCOPE instead of
+ * instantiating this directly.
+ */
+class ProfileScope {
+public:
+	ProfileScope(ProfileManager::Counter *counter) : _counter(counter) {
+		_start = ProfileManager::instance().getMicros();
+	}
+
+	~ProfileScope() {
+		ProfileManager::instance().addSample(_counter, ProfileManager::instance().getMicros() - _start);
+	}
+
+private:
+	ProfileManager::Counter *_counter;
+	uint32 _start;
+};
+
+} // End of namespace Common
+
+/** Shortcut for accessing the profile manager. */
+#define ProfileMan		Common::ProfileManager::instance()
+
+#ifdef ENABLE_PERF_COUNTERS
+#define PROFILE_SCOPE(name) \
+	static Common::ProfileManager::Counter *const profileCounter_ = ProfileMan.getCounter(name); \
+	Common::ProfileScope profileScope_(profileCounter_)
+#else
+#define PROFILE_SCOPE(name) do {} while (0)
+#endif
+
+#endif
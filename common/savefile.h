@@ -23,6 +23,7 @@
 #ifndef COMMON_SAVEFILE_H
 #define COMMON_SAVEFILE_H
 
+#include "common/func.h"
 #include "common/noncopyable.h"
 #include "common/scummsys.h"
 #include "common/stream.h"
@@ -46,6 +47,14 @@ typedef SeekableReadStream InSaveFile;
  */
 typedef WriteStream OutSaveFile;
 
+/**
+ * Called once a savefile opened with SaveFileManager::openForSavingAsync()
+ * has been written, with the name of the savefile and whether it was
+ * written successfully.
+ */
+typedef Functor2<const String &, bool, void> SaveCallback;
+
+class AsyncOutSaveFile;
 
 /**
  * The SaveFileManager is serving as a factory for InSaveFile
@@ -73,6 +82,26 @@ protected:
 	 */
 	virtual void setError(Error error, const String &errorDesc) { _error = error; _errorDesc = errorDesc; }
 
+	friend class AsyncOutSaveFile;
+
+	/**
+	 * Write a savefile opened with openForSavingAsync(), once it has been
+	 * finalized. The default implementation writes it right away through
+	 * openForSaving() and calls the callback.
+	 *
+	 * @param name      the name of the savefile
+	 * @param data      the data, allocated with malloc(); the savefile manager takes ownership of it
+	 * @param size      the size of the data
+	 * @param callback  the callback of the savefile (may be 0); the savefile manager takes ownership of it
+	 */
+	virtual void writeAsyncSave(const String &name, byte *data, uint32 size, SaveCallback *callback);
+
+	/**
+	 * Call the callback of a savefile opened with openForSavingAsync(), if
+	 * there is one, and delete it.
+	 */
+	static void finishAsyncSave(const String &name, bool success, SaveCallback *callback);
+
 public:
 	virtual ~SaveFileManager() {}
 
@@ -110,6 +139,34 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name) = 0;
 
+	/**
+	 * Open the savefile with the specified name for saving without blocking
+	 * the caller on compressing and writing it. Everything written to the
+	 * savefile is kept in memory until it is finalized (or deleted); only
+	 * then is it written, which savefile managers may spread over time.
+	 * They should write it under a temporary name first, so that an
+	 * existing savefile stays intact until the new one is complete.
+	 *
+	 * As writing may not be done yet when finalize() returns, err() only
+	 * reports errors of the savefile in memory; the outcome of writing it
+	 * is passed to the callback. The callback is called on the main thread,
+	 * but may be called while events are polled, or from within any of the
+	 * savefile manager's methods, so it should only record the outcome.
+	 *
+	 * @param name      the name of the savefile
+	 * @param callback  called when the savefile has been written (may be 0);
+	 *                  the savefile manager takes ownership of it
+	 * @return pointer to an OutSaveFile, or NULL if an error occurred.
+	 */
+	virtual OutSaveFile *openForSavingAsync(const String &name, SaveCallback *callback = 0);
+
+	/**
+	 * Wait until all savefiles opened with openForSavingAsync() have been
+	 * written. This is done after an engine quits; savefile managers which
+	 * write in the background also do it before accessing any savefile.
+	 */
+	virtual void flushAsyncSaves() {}
+
 	/**
 	 * Open the file with the specified name in the given directory for loading.
 	 * @param name	the name of the savefile
@@ -149,6 +206,31 @@ public:
 	 * @see Common::matchString()
 	 */
 	virtual StringArray listSavefiles(const String &pattern) = 0;
+
+	/**
+	 * Returns whether the save/load dialog may cache the list of save
+	 * states in a save index, see getSaveIndexName(). Managers which return
+	 * true must remove the index of the running game whenever one of its
+	 * savefiles is written or removed, and leave indexes out of
+	 * listSavefiles().
+	 */
+	virtual bool supportsSaveIndex() const { return false; }
+
+	/**
+	 * Returns the name of the savefile in which the save/load dialog caches
+	 * the list of save states of the given target, see supportsSaveIndex().
+	 * The name doesn't start with the target, so that it doesn't match the
+	 * patterns engines list their savefiles with.
+	 * @param target the target whose save states are cached
+	 * @return the name of the save index file
+	 */
+	static String getSaveIndexName(const String &target);
+
+	/**
+	 * Returns whether the given savefile is a save index, see
+	 * getSaveIndexName().
+	 */
+	static bool isSaveIndexName(const String &name);
 };
 
 } // End of namespace Common
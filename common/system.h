@@ -906,6 +906,14 @@ public:
 	/** Get the number of milliseconds since the program was started. */
 	virtual uint32 getMillis() = 0;
 
+	/**
+	 * Get the number of microseconds since the program was started, for
+	 * measuring short durations. The value wraps around after about 71
+	 * minutes. The default implementation is based on getMillis(); backends
+	 * with a finer clock should override it.
+	 */
+	virtual uint32 getMicros() { return getMillis() * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -23,6 +23,7 @@
 #define COMMON_TIMER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/str.h"
 #include "common/noncopyable.h"
 
@@ -54,6 +55,18 @@ public:
 	 * and no instance of this callback will be running anymore.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Return statistics on how late and how long the installed timers ran,
+	 * as a table with one line per timer id. Timer managers which don't
+	 * keep any statistics return an empty list.
+	 */
+	virtual Array<String> formatStats() { return Array<String>(); }
+
+	/**
+	 * Reset the statistics returned by formatStats().
+	 */
+	virtual void resetStats() {}
 };
 
 } // End of namespace Common
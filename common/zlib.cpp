@@ -24,6 +24,7 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/zlib.h"
+#include "common/profiler.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -46,6 +47,7 @@ namespace Common {
 #if defined(USE_ZLIB)
 
 bool uncompress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long srcLen) {
+	PROFILE_SCOPE("zlib uncompress");
 	return Z_OK == ::uncompress(dst, dstLen, src, srcLen);
 }
 
@@ -146,6 +148,7 @@ public:
 	}
 
 	uint32 read(void *dataPtr, uint32 dataSize) {
+		PROFILE_SCOPE("zlib inflate stream");
 		_stream.next_out = (byte *)dataPtr;
 		_stream.avail_out = dataSize;
 
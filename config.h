@@ -0,0 +1,99 @@
+/* This file is automatically generated by configure */
+/* DO NOT EDIT MANUALLY */
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+
+#define SCUMM_LITTLE_ENDIAN
+#undef SCUMM_BIG_ENDIAN
+#undef SCUMM_NEED_ALIGNMENT
+#undef USE_ELF_LOADER
+#undef DYNAMIC_MODULES
+#define USE_MT32EMU
+#undef USE_RGB_COLOR
+#undef ENABLE_PERF_COUNTERS
+#define USE_SCALERS
+#define USE_HQ_SCALERS
+#undef USE_VORBIS
+#undef USE_TREMOR
+#undef USE_FLAC
+#undef USE_MAD
+#undef USE_ALSA
+#define USE_PNG
+#undef USE_THEORADEC
+#undef USE_FAAD
+#define USE_SEQ_MIDI
+#define USE_TIMIDITY
+#define USE_ZLIB
+#undef USE_FLUIDSYNTH
+#undef USE_READLINE
+#undef USE_TEXT_CONSOLE_FOR_DEBUGGER
+#undef USE_TASKBAR_UNITY
+#undef USE_OPENGL
+#undef USE_GLES
+#undef USE_NASM
+#undef ENABLE_VKEYBD
+#undef ENABLE_KEYMAPPER
+#define USE_TRANSLATION
+#define USE_DETECTLANG
+#define USE_TASKBAR
+#define USE_BINK
+#undef USE_UPDATES
+#define ENGINE_WIP_SCUMM false
+#define ENGINE_WIP_SCUMM_7_8 false
+#define ENGINE_WIP_HE false
+#define ENGINE_WIP_AGI false
+#define ENGINE_WIP_AGOS false
+#define ENGINE_WIP_AGOS2 false
+#define ENGINE_WIP_CINE false
+#define ENGINE_WIP_COMPOSER false
+#define ENGINE_WIP_CRUISE false
+#define ENGINE_WIP_DRACI false
+#define ENGINE_WIP_DRASCULA false
+#define ENGINE_WIP_DREAMWEB false
+#define ENGINE_WIP_GOB false
+#define ENGINE_WIP_GROOVIE false
+#define ENGINE_WIP_GROOVIE2 false
+#define ENGINE_WIP_HUGO false
+#define ENGINE_WIP_KYRA false
+#define ENGINE_WIP_LOL false
+#define ENGINE_WIP_LASTEXPRESS false
+#define ENGINE_WIP_LURE false
+#define ENGINE_WIP_M4 false
+#define ENGINE_WIP_MADE false
+#define ENGINE_WIP_MOHAWK false
+#define ENGINE_WIP_CSTIME false
+#define ENGINE_WIP_RIVEN false
+#define ENGINE_WIP_MYST false
+#define ENGINE_WIP_PARALLACTION false
+#define ENGINE_WIP_QUEEN false
+#define ENGINE_WIP_SAGA false
+#define ENGINE_WIP_IHNM false
+#define ENGINE_WIP_SAGA2 false
+#define ENGINE_WIP_SCI false
+#define ENGINE_WIP_SCI32 false
+#define ENGINE_WIP_SKY false
+#define ENGINE_WIP_SWORD1 false
+#define ENGINE_WIP_SWORD2 false
+#define ENGINE_WIP_SWORD25 false
+#define ENGINE_WIP_TEENAGENT false
+#define ENGINE_WIP_TESTBED false
+#define ENGINE_WIP_TINSEL false
+#define ENGINE_WIP_TOON false
+#define ENGINE_WIP_TOUCHE false
+#define ENGINE_WIP_TSAGE false
+#define ENGINE_WIP_TUCKER false
+/* #define TAINTED_BUILD */
+
+/* Data types */
+typedef unsigned char byte;
+typedef unsigned int uint;
+typedef unsigned char uint8;
+typedef unsigned short uint16;
+typedef unsigned int uint32;
+typedef signed char int8;
+typedef signed short int16;
+typedef signed int int32;
+
+#endif /* CONFIG_H */
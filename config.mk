@@ -0,0 +1,126 @@
+# -------- Generated by configure -----------
+
+CXX := g++
+CXXFLAGS :=   -g -ansi -W -Wno-unused-parameter -Wno-empty-body -pedantic 
+LD := g++
+LIBS +=  -lm  -lpng  -lz
+RANLIB := ranlib
+STRIP := strip
+AR := ar cru
+AS := as
+ASFLAGS := 
+WINDRES := windres
+WINDRESFLAGS := 
+STAGINGPATH=staging
+WIN32PATH=c:/scummvm
+AOS4PATH=Games:ScummVM
+STATICLIBPATH=/sw
+
+BACKEND := null
+MODULES +=  backends/platform/null
+MODULE_DIRS += 
+EXEPRE := 
+EXEEXT := 
+NASM := 
+NASMFLAGS := 
+
+prefix = /usr/local
+exec_prefix = ${prefix}
+bindir = ${exec_prefix}/bin
+libdir = ${exec_prefix}/lib
+datarootdir = ${prefix}/share
+datadir = ${datarootdir}/scummvm
+mandir = ${datarootdir}/man
+docdir = ${datarootdir}/doc/scummvm
+
+
+HAVE_GCC = 1
+HAVE_GCC3 = 1
+CXX_UPDATE_DEP_FLAG = -MMD -MF "$(*D)/$(DEPDIR)/$(*F).d" -MQ "$@" -MP
+POSIX = 1
+# VERBOSE_BUILD = 1
+# USE_ELF_LOADER = 1
+# DYNAMIC_MODULES = 1
+USE_MT32EMU = 1
+# USE_RGB_COLOR = 1
+# ENABLE_PERF_COUNTERS = 1
+USE_SCALERS = 1
+USE_HQ_SCALERS = 1
+# USE_VORBIS = 1
+# USE_TREMOR = 1
+# USE_FLAC = 1
+# USE_MAD = 1
+USE_PNG = 1
+# USE_THEORADEC = 1
+# USE_FAAD = 1
+USE_ZLIB = 1
+# USE_OPENGL = 1
+# USE_GLES = 1
+# USE_NASM = 1
+# ENABLE_VKEYBD = 1
+# ENABLE_KEYMAPPER = 1
+USE_TRANSLATION = 1
+USE_TASKBAR = 1
+USE_BINK = 1
+# USE_UPDATES = 1
+ENABLE_SCUMM = STATIC_PLUGIN
+# ENABLE_SCUMM_7_8
+# ENABLE_HE
+ENABLE_AGI = STATIC_PLUGIN
+# ENABLE_AGOS
+# ENABLE_AGOS2
+# ENABLE_CINE
+# ENABLE_COMPOSER
+# ENABLE_CRUISE
+# ENABLE_DRACI
+# ENABLE_DRASCULA
+# ENABLE_DREAMWEB
+ENABLE_GOB = STATIC_PLUGIN
+# ENABLE_GROOVIE
+# ENABLE_GROOVIE2
+# ENABLE_HUGO
+# ENABLE_KYRA
+# ENABLE_LOL
+# ENABLE_LASTEXPRESS
+# ENABLE_LURE
+# ENABLE_M4
+# ENABLE_MADE
+# ENABLE_MOHAWK
+# ENABLE_CSTIME
+# ENABLE_RIVEN
+# ENABLE_MYST
+# ENABLE_PARALLACTION
+# ENABLE_QUEEN
+# ENABLE_SAGA
+# ENABLE_IHNM
+# ENABLE_SAGA2
+ENABLE_SCI = STATIC_PLUGIN
+# ENABLE_SCI32
+# ENABLE_SKY
+# ENABLE_SWORD1
+# ENABLE_SWORD2
+# ENABLE_SWORD25
+# ENABLE_TEENAGENT
+# ENABLE_TESTBED
+# ENABLE_TINSEL
+# ENABLE_TOON
+# ENABLE_TOUCHE
+# ENABLE_TSAGE
+# ENABLE_TUCKER
+
+INCLUDES +=   
+OBJS += 
+DEFINES +=  -DUSE_NULL_DRIVER -DPOSIX -DDATA_PATH=\"${datarootdir}/scummvm\" -DPLUGIN_DIRECTORY=\"${exec_prefix}/lib/scummvm\"
+LDFLAGS += 
+
+
+
+port_mk = ports.mk
+
+SAVED_CONFIGFLAGS  := --backend=null --disable-all-engines --enable-sci --enable-scumm --enable-agi --enable-gob
+SAVED_LDFLAGS      := 
+SAVED_CXX          := 
+SAVED_CXXFLAGS     := 
+SAVED_CPPFLAGS     := 
+SAVED_ASFLAGS      := 
+SAVED_WINDRESFLAGS := 
@@ -450,6 +450,7 @@ int AgiEngine::agiDeinit() {
 	cleanInput();		// remove all words from memory
 	agiUnloadResources();	// unload resources in memory
 	_loader->unloadResource(rLOGIC, 0);
+	_picture->clearCache();
 	ec = _loader->deinit();
 	unloadObjects();
 	unloadWords();
@@ -24,6 +24,7 @@
 #include "agi/graphics.h"
 
 #include "common/textconsole.h"
+#include "graphics/primitives.h"
 
 namespace Agi {
 
@@ -41,6 +42,13 @@ PictureMgr::PictureMgr(AgiBase *agi, GfxMgr *gfx) {
 	_minCommand = 0xf0;
 	_flags = 0;
 	_currentStep = 0;
+
+	_cacheSize = 0;
+	_cacheCounter = 0;
+}
+
+PictureMgr::~PictureMgr() {
+	clearCache();
 }
 
 void PictureMgr::putVirtPixel(int x, int y) {
@@ -250,6 +258,32 @@ int PictureMgr::isOkFillHere(int x, int y) {
 	return (_scrOn && (p & 0x0f) == 15 && _scrColor != 15);
 }
 
+/**
+ * Filler for Graphics::floodFill, which fills the visual and/or priority
+ * screen of the picture being drawn.
+ */
+struct PictureFiller {
+	PictureMgr *pic;
+
+	PictureFiller(PictureMgr *p) : pic(p) {}
+
+	bool isFillable(int x, int y) {
+		return pic->isOkFillHere(x, y);
+	}
+
+	void fillSpan(int x1, int x2, int y) {
+		// The span is already known to be on screen
+		uint8 *p = &pic->_vm->_game.sbuf16c[(y + pic->_yOffset) * pic->_width + x1 + pic->_xOffset];
+		const uint8 priMask = pic->_priOn ? 0x0f : 0xff;
+		const uint8 priColor = pic->_priOn ? (pic->_priColor << 4) : 0;
+		const uint8 scrMask = pic->_scrOn ? 0xf0 : 0xff;
+		const uint8 scrColor = pic->_scrOn ? pic->_scrColor : 0;
+
+		for (int x = x1; x <= x2; x++, p++)
+			*p = (((*p & priMask) | priColor) & scrMask) | scrColor;
+	}
+};
+
 /**************************************************************************
 ** agi_fill
 **************************************************************************/
@@ -257,45 +291,8 @@ void PictureMgr::agiFill(unsigned int x, unsigned int y) {
 	if (!_scrOn && !_priOn)
 		return;
 
-	// Push initial pixel on the stack
-	Common::Stack<Common::Point> stack;
-	stack.push(Common::Point(x,y));
-
-	// Exit if stack is empty
-	while (!stack.empty()) {
-		Common::Point p = stack.pop();
-		unsigned int c;
-		int newspanUp, newspanDown;
-
-		if (!isOkFillHere(p.x, p.y))
-			continue;
-
-		// Scan for left border
-		for (c = p.x - 1; isOkFillHere(c, p.y); c--)
-			;
-
-		newspanUp = newspanDown = 1;
-		for (c++; isOkFillHere(c, p.y); c++) {
-			putVirtPixel(c, p.y);
-			if (isOkFillHere(c, p.y - 1)) {
-				if (newspanUp) {
-					stack.push(Common::Point(c,p.y-1));
-					newspanUp = 0;
-				}
-			} else {
-				newspanUp = 1;
-			}
-
-			if (isOkFillHere(c, p.y + 1)) {
-				if (newspanDown) {
-					stack.push(Common::Point(c,p.y+1));
-					newspanDown = 0;
-				}
-			} else {
-				newspanDown = 1;
-			}
-		}
-	}
+	PictureFiller filler(this);
+	Graphics::floodFill(x, y, -_xOffset, -_yOffset, _width - 1 - _xOffset, _height - 1 - _yOffset, filler);
 }
 
 /**************************************************************************
@@ -820,10 +817,15 @@ int PictureMgr::decodePicture(int n, int clr, bool agi256, int pic_width, int pi
 	_width = pic_width;
 	_height = pic_height;
 
-	if (clr && !agi256) // 256 color pictures should always fill the whole screen, so no clearing for them.
-		memset(_vm->_game.sbuf16c, 0x4f, _width * _height); // Clear 16 color AGI screen (Priority 4, color white).
-
-	if (!agi256) {
+	if (clr && !agi256) { // 256 color pictures should always fill the whole screen, so no clearing for them.
+		// A picture drawn on a cleared screen always looks the same, so
+		// it is only drawn once and copied from the cache afterwards
+		if (!restoreCachedPicture(n)) {
+			memset(_vm->_game.sbuf16c, 0x4f, _width * _height); // Clear 16 color AGI screen (Priority 4, color white).
+			drawPicture(); // Draw 16 color picture.
+			cachePicture(n);
+		}
+	} else if (!agi256) {
 		drawPicture(); // Draw 16 color picture.
 	} else {
 		const uint32 maxFlen = _width * _height;
@@ -890,6 +892,58 @@ int PictureMgr::unloadPicture(int n) {
 	return errOK;
 }
 
+bool PictureMgr::restoreCachedPicture(int n) {
+	for (uint i = 0; i < _cache.size(); i++) {
+		CachedPicture &pic = _cache[i];
+		if (pic.number == n && pic.version == _pictureVersion && pic.flags == _flags) {
+			debugC(8, kDebugLevelResources, "Picture %d restored from cache", n);
+			memcpy(_vm->_game.sbuf16c, pic.screen, _width * _height);
+			pic.lastUse = ++_cacheCounter;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void PictureMgr::cachePicture(int n) {
+	const uint32 size = _width * _height;
+
+	// Make room by dropping the least recently used pictures
+	while (!_cache.empty() && _cacheSize + size > kPictureCacheBudget) {
+		uint oldest = 0;
+		for (uint i = 1; i < _cache.size(); i++) {
+			if (_cache[i].lastUse < _cache[oldest].lastUse)
+				oldest = i;
+		}
+
+		free(_cache[oldest].screen);
+		_cache.remove_at(oldest);
+		_cacheSize -= size;
+	}
+
+	CachedPicture pic;
+	pic.number = n;
+	pic.version = _pictureVersion;
+	pic.flags = _flags;
+	pic.lastUse = ++_cacheCounter;
+	pic.screen = (uint8 *)malloc(size);
+	if (!pic.screen)
+		return;
+
+	memcpy(pic.screen, _vm->_game.sbuf16c, size);
+	_cache.push_back(pic);
+	_cacheSize += size;
+}
+
+void PictureMgr::clearCache() {
+	for (uint i = 0; i < _cache.size(); i++)
+		free(_cache[i].screen);
+
+	_cache.clear();
+	_cacheSize = 0;
+}
+
 void PictureMgr::clear() {
 	memset(_vm->_game.sbuf16c, 0x4f, _width * _height);
 }
@@ -23,6 +23,8 @@
 #ifndef AGI_PICTURE_H
 #define AGI_PICTURE_H
 
+#include "common/array.h"
+
 namespace Agi {
 
 #define _DEFAULT_WIDTH		160
@@ -57,6 +59,8 @@ class AgiBase;
 class GfxMgr;
 
 class PictureMgr {
+	friend struct PictureFiller;
+
 	AgiBase *_vm;
 	GfxMgr *_gfx;
 
@@ -75,8 +79,36 @@ private:
 
 	uint8 nextByte() { return _data[_foffs++]; }
 
+	/**
+	 * A fully drawn picture, as it looks after decodePicture() with the
+	 * clear flag set. Overlays are not cached, as flood fills depend on
+	 * what has been drawn before.
+	 */
+	struct CachedPicture {
+		int number;
+		AgiPictureVersion version;
+		int flags;
+		uint32 lastUse;
+		uint8 *screen;		///< copy of the visual and priority screen
+	};
+
+	enum {
+		kPictureCacheBudget = 512 * 1024	///< maximum size of all cached screens in bytes
+	};
+
+	Common::Array<CachedPicture> _cache;
+	uint32 _cacheSize;
+	uint32 _cacheCounter;
+
+	bool restoreCachedPicture(int n);
+	void cachePicture(int n);
+
 public:
 	PictureMgr(AgiBase *agi, GfxMgr *gfx);
+	~PictureMgr();
+
+	/** Frees all cached pictures. */
+	void clearCache();
 
 	void putVirtPixel(int x, int y);
 
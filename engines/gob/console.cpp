@@ -22,8 +22,10 @@
 
 #include "gob/console.h"
 #include "gob/gob.h"
+#include "gob/global.h"
 #include "gob/inter.h"
 #include "gob/dataio.h"
+#include "gob/videoplayer.h"
 
 namespace Gob {
 
@@ -35,6 +37,8 @@ GobConsole::GobConsole(GobEngine *vm) : GUI::Debugger(), _vm(vm) {
 	DCmd_Register("var32",        WRAP_METHOD(GobConsole, cmd_var32));
 	DCmd_Register("varString",    WRAP_METHOD(GobConsole, cmd_varString));
 	DCmd_Register("listArchives", WRAP_METHOD(GobConsole, cmd_listArchives));
+	DCmd_Register("exprStats",    WRAP_METHOD(GobConsole, cmd_exprStats));
+	DCmd_Register("videoBench",   WRAP_METHOD(GobConsole, cmd_videoBenchmark));
 }
 
 GobConsole::~GobConsole() {
@@ -169,4 +173,45 @@ bool GobConsole::cmd_listArchives(int argc, const char **argv) {
 	return true;
 }
 
+bool GobConsole::cmd_exprStats(int argc, const char **argv) {
+	Global *global = _vm->_global;
+
+	if ((argc == 2) && !scumm_stricmp(argv[1], "reset")) {
+		global->_exprCacheHits   = 0;
+		global->_exprCacheMisses = 0;
+		global->_exprEvalMillis  = 0;
+		global->_exprEvalMicros  = 0;
+		return true;
+	}
+
+	uint32 count = global->_exprCacheHits + global->_exprCacheMisses;
+
+	DebugPrintf("Expressions evaluated: %d\n", count);
+	DebugPrintf("Compiled cache hits:   %d (%d%%)\n", global->_exprCacheHits,
+			count ? (global->_exprCacheHits * 100 / count) : 0);
+	DebugPrintf("Evaluation time:       %d.%03d ms\n", global->_exprEvalMillis, global->_exprEvalMicros);
+
+	return true;
+}
+
+bool GobConsole::cmd_videoBenchmark(int argc, const char **argv) {
+	if (argc != 2) {
+		DebugPrintf("Usage: %s <video file>\n", argv[0]);
+		return true;
+	}
+
+	uint32 frames, micros, maxMicros;
+	if (!_vm->_vidPlayer->benchmarkVideo(argv[1], frames, micros, maxMicros)) {
+		DebugPrintf("Can't open video \"%s\"\n", argv[1]);
+		return true;
+	}
+
+	DebugPrintf("Frames decoded:    %d\n", frames);
+	DebugPrintf("Total time:        %d.%03d ms\n", micros / 1000, micros % 1000);
+	DebugPrintf("Average per frame: %d us\n", frames ? (micros / frames) : 0);
+	DebugPrintf("Slowest frame:     %d us\n", maxMicros);
+
+	return true;
+}
+
 } // End of namespace Gob
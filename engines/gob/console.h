@@ -45,6 +45,8 @@ private:
 	bool cmd_varString(int argc, const char **argv);
 
 	bool cmd_listArchives(int argc, const char **argv);
+	bool cmd_exprStats(int argc, const char **argv);
+	bool cmd_videoBenchmark(int argc, const char **argv);
 };
 
 } // End of namespace Gob
@@ -21,6 +21,7 @@
  */
 
 #include "common/endian.h"
+#include "common/profiler.h"
 
 #include "gob/gob.h"
 #include "gob/expression.h"
@@ -64,6 +65,14 @@ void Expression::StackFrame::pop(int count) {
 Expression::Expression(GobEngine *vm) : _vm(vm) {
 	_resultStr[0] = 0;
 	_resultInt = 0;
+
+	_cacheData = 0;
+	_parseDepth = 0;
+}
+
+void Expression::clearCache() {
+	_cache.clear();
+	_cacheData = 0;
 }
 
 int32 Expression::encodePtr(byte *ptr, int type) {
@@ -996,6 +1005,239 @@ void Expression::getResult(byte operation, int32 value, byte *type) {
 }
 
 int16 Expression::parseExpr(byte stopToken, byte *type) {
+	// Only time the outermost expression, nested ones are included in it
+	uint32 startTime = 0;
+	if (_parseDepth++ == 0)
+		startTime = ProfileMan.getMicros();
+
+	if (!evalCompiledExpr(stopToken, type))
+		parseExprUncached(stopToken, type);
+
+	if (--_parseDepth == 0) {
+		_vm->_global->_exprEvalMicros += ProfileMan.getMicros() - startTime;
+		_vm->_global->_exprEvalMillis += _vm->_global->_exprEvalMicros / 1000;
+		_vm->_global->_exprEvalMicros %= 1000;
+	}
+
+	return 0;
+}
+
+bool Expression::compileExpr(const byte *data, uint32 size, byte stopToken, CompiledExpr &expr) const {
+	enum {
+		// The stack of parseExpr() only has room for this many terms
+		kMaxTerms = 8
+	};
+
+	expr.valid = false;
+	expr.stopToken = stopToken;
+	expr.size = 0;
+	expr.ops.clear();
+
+	// A stop token that is also an operand, operator or variable base
+	// prefix would be ambiguous
+	if ((stopToken >= OP_NEG) && (stopToken <= OP_NEQ) &&
+	    (stopToken != OP_END_EXPR) && (stopToken != OP_END_MARKER))
+		return false;
+
+	Common::Array<byte> addOps;
+	byte mulOp = 0;
+	uint32 pos = 0;
+
+	while (true) {
+		if ((pos + 1) >= size)
+			return false;
+
+		bool negate = false;
+		if (data[pos] == OP_NEG) {
+			negate = true;
+			if (++pos >= size)
+				return false;
+		}
+
+		CompiledOp load;
+		load.operation = data[pos++];
+
+		uint32 operandSize;
+		switch (load.operation) {
+		case OP_LOAD_IMM_INT8:
+			operandSize = 1;
+			break;
+		case OP_LOAD_IMM_INT32:
+			operandSize = 4;
+			break;
+		case OP_LOAD_IMM_INT16:
+		case OP_LOAD_VAR_INT8:
+		case OP_LOAD_VAR_INT16:
+		case OP_LOAD_VAR_INT32:
+		case OP_LOAD_VAR_INT32_AS_INT16:
+			operandSize = 2;
+			break;
+		default:
+			// Arrays, strings, functions, brackets and variable bases
+			return false;
+		}
+
+		if ((pos + operandSize) >= size)
+			return false;
+
+		switch (load.operation) {
+		case OP_LOAD_IMM_INT8:
+			load.operation = OP_LOAD_IMM_INT16;
+			load.value = (int8) data[pos];
+			break;
+		case OP_LOAD_IMM_INT16:
+			load.value = (int16) READ_LE_UINT16(data + pos);
+			break;
+		case OP_LOAD_IMM_INT32:
+			load.operation = OP_LOAD_IMM_INT16;
+			load.value = (int32) READ_LE_UINT32(data + pos);
+			break;
+		case OP_LOAD_VAR_INT8:
+			load.value = READ_LE_UINT16(data + pos);
+			break;
+		case OP_LOAD_VAR_INT16:
+			load.value = READ_LE_UINT16(data + pos) * 2;
+			break;
+		default:
+			load.value = READ_LE_UINT16(data + pos) * 4;
+			break;
+		}
+		pos += operandSize;
+
+		expr.ops.push_back(load);
+
+		CompiledOp op;
+		op.value = 0;
+
+		if (negate) {
+			op.operation = OP_NEG;
+			expr.ops.push_back(op);
+		}
+
+		if (mulOp) {
+			op.operation = mulOp;
+			expr.ops.push_back(op);
+			mulOp = 0;
+		}
+
+		byte operation = data[pos++];
+		if (operation == stopToken)
+			break;
+
+		if ((operation == OP_MUL) || (operation == OP_DIV) ||
+		    (operation == OP_MOD) || (operation == OP_BITAND)) {
+			mulOp = operation;
+		} else if ((operation == OP_ADD) || (operation == OP_SUB) || (operation == OP_BITOR)) {
+			if (addOps.size() >= kMaxTerms)
+				return false;
+			addOps.push_back(operation);
+		} else
+			return false;
+	}
+
+	// parseExpr() applies the additive operators from right to left once
+	// the stop token is reached, always to the first term
+	for (uint i = addOps.size(); i > 0; i--) {
+		CompiledOp op;
+		op.operation = addOps[i - 1];
+		op.value = i;
+		expr.ops.push_back(op);
+	}
+
+	expr.size = pos;
+	expr.valid = true;
+	return true;
+}
+
+bool Expression::evalCompiledExpr(byte stopToken, byte *type) {
+	Script *script = _vm->_game->_script;
+
+	const byte *data = script->getData();
+	if (!data)
+		return false;
+
+	if (data != _cacheData) {
+		_cache.clear();
+		_cacheData = data;
+	}
+
+	uint32 offset = script->pos();
+
+	CompiledExprMap::iterator expr = _cache.find(offset);
+	if (expr == _cache.end()) {
+		compileExpr(data + offset, script->getSize() - offset, stopToken, _cache[offset]);
+		expr = _cache.find(offset);
+	}
+
+	if (!expr->_value.valid || (expr->_value.stopToken != stopToken)) {
+		_vm->_global->_exprCacheMisses++;
+		return false;
+	}
+
+	_vm->_global->_exprCacheHits++;
+
+	int32 terms[20];
+	int n = -1;
+
+	const Common::Array<CompiledOp> &ops = expr->_value.ops;
+	for (Common::Array<CompiledOp>::const_iterator op = ops.begin(); op != ops.end(); ++op) {
+		switch (op->operation) {
+		case OP_LOAD_IMM_INT16:
+			terms[++n] = op->value;
+			break;
+		case OP_LOAD_VAR_INT8:
+			terms[++n] = (int8) READ_VARO_UINT8(op->value);
+			break;
+		case OP_LOAD_VAR_INT16:
+		case OP_LOAD_VAR_INT32_AS_INT16:
+			terms[++n] = (int16) READ_VARO_UINT16(op->value);
+			break;
+		case OP_LOAD_VAR_INT32:
+			terms[++n] = READ_VARO_UINT32(op->value);
+			break;
+
+		case OP_NEG:
+			terms[n] = -terms[n];
+			break;
+		case OP_MUL:
+			terms[n - 1] *= terms[n];
+			n--;
+			break;
+		case OP_DIV:
+			terms[n - 1] /= terms[n];
+			n--;
+			break;
+		case OP_MOD:
+			terms[n - 1] %= terms[n];
+			n--;
+			break;
+		case OP_BITAND:
+			terms[n - 1] &= terms[n];
+			n--;
+			break;
+
+		case OP_ADD:
+			terms[0] += terms[op->value];
+			break;
+		case OP_SUB:
+			terms[0] -= terms[op->value];
+			break;
+		case OP_BITOR:
+			terms[0] |= terms[op->value];
+			break;
+		}
+	}
+
+	script->skip(expr->_value.size);
+
+	_resultInt = terms[0];
+	if (type)
+		*type = OP_LOAD_IMM_INT16;
+
+	return true;
+}
+
+int16 Expression::parseExprUncached(byte stopToken, byte *type) {
 	Stack stack;
 	StackFrame stackFrame(stack);
 	byte operation;
@@ -24,6 +24,8 @@
 #define GOB_EXPRESSION_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 
 namespace Gob {
 
@@ -122,6 +124,9 @@ public:
 	int32 getResultInt();
 	char *getResultStr();
 
+	/** Forget all compiled expressions. */
+	void clearCache();
+
 private:
 	class Stack {
 	public:
@@ -149,11 +154,42 @@ private:
 		kResStr   = 2
 	};
 
+	/** An instruction of a compiled expression. */
+	struct CompiledOp {
+		byte operation; ///< OP_LOAD_IMM_INT16, a variable load or an arithmetic operator
+		int32 value;    ///< The immediate value or the variable offset
+	};
+
+	/**
+	 * A compiled integer expression.
+	 *
+	 * Only expressions consisting of immediate values, plain variables,
+	 * negation and arithmetic operators are compiled. The terms of the
+	 * multiplicative operators are evaluated from left to right, the
+	 * additive operators are then applied from right to left, exactly like
+	 * parseExpr() does it on its stack.
+	 */
+	struct CompiledExpr {
+		bool valid;    ///< Was the expression simple enough to be compiled?
+		byte stopToken;
+		uint32 size;   ///< Size of the expression in the script, including the stop token
+		Common::Array<CompiledOp> ops;
+	};
+
+	typedef Common::HashMap<uint32, CompiledExpr> CompiledExprMap;
+
 	GobEngine *_vm;
 
 	int32 _resultInt;
 	char _resultStr[200];
 
+	/** The script data the compiled expressions refer to. */
+	const byte *_cacheData;
+	/** The compiled expressions, by their offset in the script. */
+	CompiledExprMap _cache;
+	/** Nesting depth of parseExpr(), to only time the outermost call. */
+	int _parseDepth;
+
 	int32 encodePtr(byte *ptr, int type);
 	byte *decodePtr(int32 n);
 
@@ -164,6 +200,11 @@ private:
 	int cmpHelper(const StackFrame &stackFrame);
 	void loadValue(byte operation, uint32 varBase, const StackFrame &stackFrame);
 
+	int16 parseExprUncached(byte stopToken, byte *type);
+
+	bool compileExpr(const byte *data, uint32 size, byte stopToken, CompiledExpr &expr) const;
+	bool evalCompiledExpr(byte stopToken, byte *type);
+
 	void simpleArithmetic1(StackFrame &stackFrame);
 	void simpleArithmetic2(StackFrame &stackFrame);
 	bool complexArithmetic(Stack &stack, StackFrame &stackFrame, int16 brackStart);
@@ -125,6 +125,11 @@ Global::Global(GobEngine *vm) : _vm(vm) {
 	_noCd = false;
 
 	_curWinId = 0;
+
+	_exprCacheHits   = 0;
+	_exprCacheMisses = 0;
+	_exprEvalMillis  = 0;
+	_exprEvalMicros  = 0;
 }
 
 Global::~Global() {
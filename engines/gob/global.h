@@ -143,6 +143,12 @@ public:
 
 	int16 _curWinId;
 
+	// Statistics of the compiled expression cache, shown by the console
+	uint32 _exprCacheHits;
+	uint32 _exprCacheMisses;
+	uint32 _exprEvalMillis;
+	uint32 _exprEvalMicros;
+
 	Global(GobEngine *vm);
 	~Global();
 
@@ -415,6 +415,8 @@ void Script::unloadTOT() {
 
 	delete[] _totData;
 
+	_expression->clearCache();
+
 	_totData = 0;
 	_totSize = 0;
 	_totPtr = 0;
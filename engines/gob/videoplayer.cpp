@@ -31,6 +31,8 @@
 #include "gob/map.h"
 #include "gob/sound/sound.h"
 
+#include "common/profiler.h"
+
 namespace Gob {
 
 VideoPlayer::Properties::Properties() : type(kVideoTypeTry), sprite(Draw::kFrontSurface),
@@ -850,6 +852,37 @@ Common::String VideoPlayer::findFile(const Common::String &file, Properties &pro
 	return video;
 }
 
+bool VideoPlayer::benchmarkVideo(const Common::String &file, uint32 &frames, uint32 &micros, uint32 &maxMicros) {
+	Properties properties;
+
+	frames    = 0;
+	micros    = 0;
+	maxMicros = 0;
+
+	::Video::CoktelDecoder *video = openVideo(file, properties);
+	if (!video)
+		return false;
+
+	video->disableSound();
+	video->setSurfaceMemory();
+	video->setXY(0, 0);
+
+	while (!video->endOfVideo()) {
+		uint32 start = ProfileMan.getMicros();
+
+		video->decodeNextFrame();
+
+		uint32 frameMicros = ProfileMan.getMicros() - start;
+
+		frames++;
+		micros   += frameMicros;
+		maxMicros = MAX(maxMicros, frameMicros);
+	}
+
+	delete video;
+	return true;
+}
+
 void VideoPlayer::copyPalette(const Video &video, int16 palStart, int16 palEnd) {
 	if (!video.decoder->hasPalette() || !video.decoder->isPaletted())
 		return;
@@ -148,6 +148,18 @@ public:
 			uint16 left, uint16 top, uint16 width, uint16 height, uint16 x, uint16 y,
 			int32 transp = -1) const;
 
+	/**
+	 * Decode all frames of a video as fast as possible, without sound and
+	 * without drawing them anywhere.
+	 *
+	 * @param file      The video to decode.
+	 * @param frames    Set to the number of decoded frames.
+	 * @param micros    Set to the total decoding time in microseconds.
+	 * @param maxMicros Set to the decoding time of the slowest frame.
+	 * @return true if the video could be opened.
+	 */
+	bool benchmarkVideo(const Common::String &file, uint32 &frames, uint32 &micros, uint32 &maxMicros);
+
 private:
 	struct Video {
 		::Video::CoktelDecoder *decoder;
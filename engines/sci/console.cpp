@@ -77,6 +77,9 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	assert(_engine);
 	assert(_engine->_gamestate);
 
+	_benchmarkSteps = 0;
+	_benchmarkStartTime = 0;
+
 	// Variables
 	DVar_Register("sleeptime_factor",	&g_debug_sleeptime_factor, DVAR_INT, 0);
 	DVar_Register("gc_interval",		&engine->_gamestate->scriptGCInterval, DVAR_INT, 0);
@@ -201,6 +204,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	DCmd_Register("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	DCmd_Register("selector_cache",		WRAP_METHOD(Console, cmdSelectorCache));
+	DCmd_Register("pathfinding_stats",	WRAP_METHOD(Console, cmdPathfindingStats));
 	DCmd_Register("vm_varlist",			WRAP_METHOD(Console, cmdVMVarlist));
 	DCmd_Register("vmvarlist",			WRAP_METHOD(Console, cmdVMVarlist));				// alias
 	DCmd_Register("vl",					WRAP_METHOD(Console, cmdVMVarlist));				// alias
@@ -420,7 +425,9 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" bp_function / bpe - Sets a breakpoint on the execution of the specified exported function\n");
 	DebugPrintf("\n");
 	DebugPrintf("VM:\n");
-	DebugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	DebugPrintf(" script_steps - Shows the number of executed SCI operations and the VM throughput\n");
+	DebugPrintf(" selector_cache - Shows or resets the selector lookup cache statistics\n");
+	DebugPrintf(" pathfinding_stats - Shows or resets the kAvoidPath timing and visibility cache statistics\n");
 	DebugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	DebugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	DebugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -2635,7 +2642,77 @@ bool Console::cmdViewAccumulatorObject(int argc, const char **argv) {
 }
 
 bool Console::cmdScriptSteps(int argc, const char **argv) {
-	DebugPrintf("Number of executed SCI operations: %d\n", _engine->_gamestate->scriptStepCounter);
+	const int steps = _engine->_gamestate->scriptStepCounter;
+	const uint32 now = g_system->getMillis();
+
+	DebugPrintf("Number of executed SCI operations: %d\n", steps);
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		_benchmarkSteps = steps;
+		_benchmarkStartTime = now;
+		DebugPrintf("Throughput measurement started\n");
+	} else if (argc != 1) {
+		DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		DebugPrintf("Use 'reset' to start measuring the VM throughput, then run\n");
+		DebugPrintf("the game for a while and call %s again.\n", argv[0]);
+	} else if (_benchmarkStartTime && now > _benchmarkStartTime && steps >= _benchmarkSteps) {
+		const uint32 elapsed = now - _benchmarkStartTime;
+		const uint32 measuredSteps = steps - _benchmarkSteps;
+		DebugPrintf("%d operations in %d ms (%d operations/s)\n",
+				measuredSteps, elapsed, (int)((double)measuredSteps * 1000 / elapsed));
+	}
+
+	return true;
+}
+
+bool Console::cmdSelectorCache(int argc, const char **argv) {
+	SegManager *segMan = _engine->_gamestate->_segMan;
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		segMan->_selectorCacheHits = 0;
+		segMan->_selectorCacheMisses = 0;
+		segMan->_selectorCacheSaved = 0;
+		DebugPrintf("Selector cache statistics reset\n");
+		return true;
+	} else if (argc != 1) {
+		DebugPrintf("Shows the selector lookup cache statistics.\n");
+		DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const uint32 lookups = segMan->_selectorCacheHits + segMan->_selectorCacheMisses;
+	DebugPrintf("Selector lookups: %d\n", lookups);
+	DebugPrintf("Cache hits: %d (%d%%)\n", segMan->_selectorCacheHits,
+			lookups ? segMan->_selectorCacheHits * 100 / lookups : 0);
+	DebugPrintf("Cache misses: %d\n", segMan->_selectorCacheMisses);
+	DebugPrintf("Selector comparisons saved: %d\n", segMan->_selectorCacheSaved);
+	return true;
+}
+
+bool Console::cmdPathfindingStats(int argc, const char **argv) {
+	EngineState *s = _engine->_gamestate;
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		s->_pathfindingCalls = 0;
+		s->_pathfindingMicros = 0;
+		s->_pathfindingGraphHits = 0;
+		s->_pathfindingGraphMisses = 0;
+		DebugPrintf("Pathfinding statistics reset\n");
+		return true;
+	} else if (argc != 1) {
+		DebugPrintf("Shows the time spent in kAvoidPath and the visibility cache statistics.\n");
+		DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const uint32 pairs = s->_pathfindingGraphHits + s->_pathfindingGraphMisses;
+	DebugPrintf("Path queries: %d\n", s->_pathfindingCalls);
+	DebugPrintf("Total time: %d us (%d us per query)\n", s->_pathfindingMicros,
+			s->_pathfindingCalls ? s->_pathfindingMicros / s->_pathfindingCalls : 0);
+	DebugPrintf("Cached visibility graphs: %d\n", s->_pathfindingGraphs.size());
+	DebugPrintf("Vertex pairs from cache: %d (%d%%)\n", s->_pathfindingGraphHits,
+			pairs ? s->_pathfindingGraphHits * 100 / pairs : 0);
+	DebugPrintf("Vertex pairs checked: %d\n", s->_pathfindingGraphMisses);
 	return true;
 }
 
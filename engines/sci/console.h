@@ -144,6 +144,8 @@ private:
 	bool cmdBreakpointFunction(int argc, const char **argv);
 	// VM
 	bool cmdScriptSteps(int argc, const char **argv);
+	bool cmdSelectorCache(int argc, const char **argv);
+	bool cmdPathfindingStats(int argc, const char **argv);
 	bool cmdVMVarlist(int argc, const char **argv);
 	bool cmdVMVars(int argc, const char **argv);
 	bool cmdStack(int argc, const char **argv);
@@ -176,6 +178,8 @@ private:
 	bool _mouseVisible;
 	Common::String _videoFile;
 	int _videoFrameDelay;
+	int _benchmarkSteps;
+	uint32 _benchmarkStartTime;
 };
 
 } // End of namespace Sci
@@ -30,6 +30,7 @@
 
 #include "common/debug-channels.h"
 #include "common/list.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 namespace Sci {
@@ -94,23 +95,24 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// A* open set insertion order (0 if never opened) and closed flag
+	uint32 openSeq;
+	bool closed;
+
+	// Index into the cached visibility graph, or -1 if not part of it
+	int graphIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		openSeq = 0;
+		closed = false;
+		graphIndex = -1;
 	}
 };
 
-class VertexList: public Common::List<Vertex *> {
-public:
-	bool contains(Vertex *v) {
-		for (iterator it = begin(); it != end(); ++it) {
-			if (v == *it)
-				return true;
-		}
-		return false;
-	}
-};
+typedef Common::List<Vertex *> VertexList;
 
 /* Circular list definitions. */
 
@@ -235,6 +237,10 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Cached visibility between the obstacle vertices, may be NULL
+	PathfindingGraph *_graph;
+	uint32 _graphHits, _graphMisses;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -242,6 +248,9 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		_graph = NULL;
+		_graphHits = 0;
+		_graphMisses = 0;
 	}
 
 	~PathfindingState() {
@@ -637,6 +646,50 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+// Visibility graph entries
+enum {
+	GRAPH_UNKNOWN = 0,
+	GRAPH_VISIBLE = 1,
+	GRAPH_HIDDEN = 2
+};
+
+// Maximum number of cached visibility graphs and vertices per graph
+#define GRAPH_CACHE_SIZE 4
+#define GRAPH_MAX_VERTICES 256
+
+/**
+ * Determines whether a vertex is visible from another vertex.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to look at
+ * @return true if the line between both vertices is unobstructed
+ */
+static bool vertex_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -645,34 +698,34 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	PathfindingGraph *graph = (vertex_cur->graphIndex >= 0) ? s->_graph : NULL;
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		if (vertex == vertex_cur)
 			continue;
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+		bool visible;
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
+		if (graph && vertex->graphIndex >= 0) {
+			// Both vertices are obstacle vertices, so their visibility only
+			// depends on the obstacles and can be taken from the graph
+			byte &entry = graph->visibility[vertex_cur->graphIndex * graph->vertexCount + vertex->graphIndex];
+
+			if (entry == GRAPH_UNKNOWN) {
+				entry = vertex_visible(s, vertex_cur, vertex) ? GRAPH_VISIBLE : GRAPH_HIDDEN;
+				s->_graphMisses++;
+			} else {
+				s->_graphHits++;
 			}
+
+			visible = (entry == GRAPH_VISIBLE);
+		} else {
+			visible = vertex_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1280,6 +1333,149 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	return pf_s;
 }
 
+/**
+ * Numbers the obstacle vertices of the pathfinding state and looks up the
+ * cached visibility graph for these obstacles, creating an empty one if none
+ * exists yet. Vertices that have no edges (usually the start and end points)
+ * are not part of the graph, as they don't block any other vertices.
+ * Parameters: (EngineState *) s: The game state
+ *             (PathfindingState *) p: The pathfinding state
+ */
+static void attach_graph(EngineState *s, PathfindingState *p) {
+	Common::Array<int16> obstacles;
+	uint count = 0;
+
+	for (PolygonList::iterator it = p->polygons.begin(); it != p->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
+
+		if (!VERTEX_HAS_EDGES(polygon->vertices.first()))
+			continue;
+
+		obstacles.push_back(polygon->vertices.size());
+
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			obstacles.push_back(vertex->v.x);
+			obstacles.push_back(vertex->v.y);
+			vertex->graphIndex = count++;
+		}
+	}
+
+	if (count < 2 || count > GRAPH_MAX_VERTICES)
+		return;
+
+	Common::List<PathfindingGraph>::iterator oldest = s->_pathfindingGraphs.end();
+
+	for (Common::List<PathfindingGraph>::iterator it = s->_pathfindingGraphs.begin(); it != s->_pathfindingGraphs.end(); ++it) {
+		if (it->obstacles == obstacles) {
+			it->lastUse = s->_pathfindingCalls;
+			p->_graph = &*it;
+			return;
+		}
+
+		if (oldest == s->_pathfindingGraphs.end() || it->lastUse < oldest->lastUse)
+			oldest = it;
+	}
+
+	if (s->_pathfindingGraphs.size() >= GRAPH_CACHE_SIZE)
+		s->_pathfindingGraphs.erase(oldest);
+
+	s->_pathfindingGraphs.push_front(PathfindingGraph());
+
+	PathfindingGraph &graph = s->_pathfindingGraphs.front();
+	graph.obstacles = obstacles;
+	graph.vertexCount = count;
+	graph.visibility.resize(count * count);
+	memset(graph.visibility.begin(), GRAPH_UNKNOWN, count * count);
+	graph.lastUse = s->_pathfindingCalls;
+	p->_graph = &graph;
+}
+
+/**
+ * Binary heap of the vertices in the A* open set, ordered by F cost. Ties
+ * go to the vertex that entered the open set last. Entries are not removed
+ * when a vertex gets a lower cost, stale entries are skipped instead.
+ */
+class OpenSet {
+	struct Entry {
+		uint32 costF;
+		uint32 seq;
+		Vertex *vertex;
+
+		bool operator<(const Entry &other) const {
+			return (costF < other.costF) || ((costF == other.costF) && (seq > other.seq));
+		}
+	};
+
+	Common::Array<Entry> _heap;
+	uint32 _seq;
+
+public:
+	OpenSet() : _seq(0) {}
+
+	/**
+	 * Adds a vertex or updates its position after its cost changed.
+	 */
+	void push(Vertex *vertex) {
+		if (!vertex->openSeq)
+			vertex->openSeq = ++_seq;
+
+		Entry entry;
+		entry.costF = vertex->costF;
+		entry.seq = vertex->openSeq;
+		entry.vertex = vertex;
+
+		uint i = _heap.size();
+		_heap.push_back(entry);
+
+		while (i > 0) {
+			uint parent = (i - 1) / 2;
+			if (!(entry < _heap[parent]))
+				break;
+			_heap[i] = _heap[parent];
+			i = parent;
+		}
+
+		_heap[i] = entry;
+	}
+
+	/**
+	 * Returns the open vertex with the lowest F cost, or NULL if there is none.
+	 */
+	Vertex *top() {
+		while (!_heap.empty()) {
+			const Entry &entry = _heap.front();
+			if (!entry.vertex->closed && entry.costF == entry.vertex->costF)
+				return entry.vertex;
+			pop();
+		}
+
+		return NULL;
+	}
+
+	void pop() {
+		Entry last = _heap.back();
+		_heap.pop_back();
+
+		uint size = _heap.size();
+		if (!size)
+			return;
+
+		uint i = 0;
+		while (2 * i + 1 < size) {
+			uint child = 2 * i + 1;
+			if (child + 1 < size && _heap[child + 1] < _heap[child])
+				child++;
+			if (!(_heap[child] < last))
+				break;
+			_heap[i] = _heap[child];
+			i = child;
+		}
+
+		_heap[i] = last;
+	}
+};
+
 /**
  * Computes a shortest path from vertex_start to vertex_end. The caller can
  * construct the resulting path by following the path_prev links from
@@ -1288,40 +1484,23 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
+	// The vertices of which the shortest path is not known yet. Vertices
+	// of which it is known are flagged as closed.
+	OpenSet openSet;
+	Vertex *vertex_min = NULL;
 
-	// The remaining vertices
-	VertexList openSet;
-
-	openSet.push_front(s->vertex_start);
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
+	openSet.push(s->vertex_start);
 
-	while (!openSet.empty()) {
-		// Find vertex in open set with lowest F cost
-		VertexList::iterator vertex_min_it = openSet.end();
-		Vertex *vertex_min = 0;
-		uint32 min = HUGE_DISTANCE;
-
-		for (VertexList::iterator it = openSet.begin(); it != openSet.end(); ++it) {
-			Vertex *vertex = *it;
-			if (vertex->costF < min) {
-				vertex_min_it = it;
-				vertex_min = *vertex_min_it;
-				min = vertex->costF;
-			}
-		}
-
-		assert(vertex_min != 0);	// the vertex cost should never be bigger than HUGE_DISTANCE
-
+	while ((vertex_min = openSet.top()) != NULL) {
 		// Check if we are done
 		if (vertex_min == s->vertex_end)
 			break;
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
-		openSet.erase(vertex_min_it);
+		vertex_min->closed = true;
+		openSet.pop();
 
 		VertexList *visVerts = visible_vertices(s, vertex_min);
 
@@ -1329,12 +1508,9 @@ static void AStar(PathfindingState *s) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->closed)
 				continue;
 
-			if (!openSet.contains(vertex))
-				openSet.push_front(vertex);
-
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
 			// When travelling to a vertex on the screen edge, we
@@ -1351,13 +1527,14 @@ static void AStar(PathfindingState *s) {
 				vertex->costG = new_dist;
 				vertex->costF = vertex->costG + (uint32)sqrt((float)vertex->v.sqrDist(s->vertex_end->v));
 				vertex->path_prev = vertex_min;
+				openSet.push(vertex);
 			}
 		}
 
 		delete visVerts;
 	}
 
-	if (openSet.empty())
+	if (!vertex_min)
 		debugC(kDebugLevelAvoidPath, "AvoidPath: End point (%i, %i) is unreachable", s->vertex_end->v.x, s->vertex_end->v.y);
 }
 
@@ -1515,6 +1692,9 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 				g_system->delayMillis(2500);
 		}
 
+		const uint32 startTime = ProfileMan.getMicros();
+		s->_pathfindingCalls++;
+
 		PathfindingState *p = convert_polygon_set(s, poly_list, start, end, width, height, opt);
 
 		if (!p) {
@@ -1532,12 +1712,19 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 			return output;
 		}
 
+		attach_graph(s, p);
+
 		// Apply Dijkstra
 		AStar(p);
 
+		s->_pathfindingGraphHits += p->_graphHits;
+		s->_pathfindingGraphMisses += p->_graphMisses;
+
 		output = output_path(p, s);
 		delete p;
 
+		s->_pathfindingMicros += ProfileMan.getMicros() - startTime;
+
 		// Memory is freed by explicit calls to Memory
 		return output;
 	}
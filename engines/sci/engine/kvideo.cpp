@@ -34,6 +34,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "video/video_decoder.h"
+#include "video/buffered_decoder.h"
 #include "video/avi_decoder.h"
 #include "video/qt_decoder.h"
 #include "sci/video/seq_decoder.h"
@@ -85,12 +86,16 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 
 	bool skipVideo = false;
 
-	if (videoDecoder->hasDirtyPalette())
-		videoDecoder->setSystemPalette();
+	// Decode frames ahead while waiting for the next frame to be due, so
+	// that slow frames don't hold up the playback
+	Video::BufferedVideoDecoder *bufferedDecoder = new Video::BufferedVideoDecoder(videoDecoder);
 
-	while (!g_engine->shouldQuit() && !videoDecoder->endOfVideo() && !skipVideo) {
-		if (videoDecoder->needsUpdate()) {
-			const Graphics::Surface *frame = videoDecoder->decodeNextFrame();
+	if (bufferedDecoder->hasDirtyPalette())
+		bufferedDecoder->setSystemPalette();
+
+	while (!g_engine->shouldQuit() && !bufferedDecoder->endOfVideo() && !skipVideo) {
+		if (bufferedDecoder->needsUpdate()) {
+			const Graphics::Surface *frame = bufferedDecoder->decodeNextFrame();
 
 			if (frame) {
 				if (scaleBuffer) {
@@ -101,8 +106,8 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 					g_system->copyRectToScreen((byte *)frame->pixels, frame->pitch, x, y, width, height);
 				}
 
-				if (videoDecoder->hasDirtyPalette())
-					videoDecoder->setSystemPalette();
+				if (bufferedDecoder->hasDirtyPalette())
+					bufferedDecoder->setSystemPalette();
 
 				g_system->updateScreen();
 			}
@@ -114,11 +119,19 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 				skipVideo = true;
 		}
 
-		g_system->delayMillis(10);
+		uint32 startTime = g_system->getMillis();
+		bufferedDecoder->decodeAhead(MIN<uint32>(bufferedDecoder->getTimeToNextFrame(), 10));
+
+		uint32 decodeTime = g_system->getMillis() - startTime;
+		if (decodeTime < 10)
+			g_system->delayMillis(10 - decodeTime);
 	}
 
+	if (bufferedDecoder->getDroppedFrames())
+		debug(1, "Dropped %d late video frames", bufferedDecoder->getDroppedFrames());
+
 	delete[] scaleBuffer;
-	delete videoDecoder;
+	delete bufferedDecoder;
 }
 
 reg_t kShowMovie(EngineState *s, int argc, reg_t *argv) {
@@ -43,6 +43,10 @@ SegManager::SegManager(ResourceManager *resMan) {
 
 	_resMan = resMan;
 
+	_selectorCacheHits = 0;
+	_selectorCacheMisses = 0;
+	_selectorCacheSaved = 0;
+
 	createClassTable();
 }
 
@@ -51,6 +55,8 @@ SegManager::~SegManager() {
 }
 
 void SegManager::resetSegMan() {
+	flushSelectorCache();
+
 	// Free memory
 	for (uint i = 0; i < _heap.size(); i++) {
 		if (_heap[i])
@@ -77,6 +83,33 @@ void SegManager::resetSegMan() {
 	createClassTable();
 }
 
+const SegManager::SelectorCacheEntry *SegManager::getCachedSelector(reg_t objPos, Selector selector) {
+	SelectorCacheKey key;
+	key.objPos = objPos;
+	key.selector = selector;
+
+	Common::HashMap<SelectorCacheKey, SelectorCacheEntry, SelectorCacheKey_Hash>::const_iterator it = _selectorCache.find(key);
+	if (it == _selectorCache.end()) {
+		_selectorCacheMisses++;
+		return NULL;
+	}
+
+	_selectorCacheHits++;
+	_selectorCacheSaved += it->_value.cost;
+	return &it->_value;
+}
+
+void SegManager::cacheSelector(reg_t objPos, Selector selector, const SelectorCacheEntry &entry) {
+	SelectorCacheKey key;
+	key.objPos = objPos;
+	key.selector = selector;
+	_selectorCache[key] = entry;
+}
+
+void SegManager::flushSelectorCache() {
+	_selectorCache.clear();
+}
+
 void SegManager::initSysStrings() {
 	if (getSciVersion() <= SCI_VERSION_1_1) {
 		// We need to allocate system strings in one segment, for compatibility reasons
@@ -150,6 +183,7 @@ void SegManager::deallocate(SegmentId seg) {
 
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
+		flushSelectorCache();
 		_scriptSegMap.erase(scr->getScriptNumber());
 		if (scr->_localsSegment)
 			deallocate(scr->_localsSegment);
@@ -999,6 +1033,8 @@ int SegManager::instantiateScript(int scriptNum) {
 		scr = allocateScript(scriptNum, &segmentId);
 	}
 
+	flushSelectorCache();
+
 	scr->init(scriptNum, _resMan);
 	scr->load(_resMan);
 	scr->initializeLocals(this);
@@ -1035,6 +1071,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		flushSelectorCache();
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
@@ -441,12 +441,63 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * A cached result of lookupSelector(). The cost is the number of
+	 * selector comparisons the uncached lookup needed.
+	 */
+	struct SelectorCacheEntry {
+		SelectorType type;
+		int varIndex;
+		reg_t funcAddr;
+		uint cost;
+	};
+
+	/**
+	 * Looks up a cached selector lookup result.
+	 * @param objPos	the base position of the object (Object::getPos())
+	 * @param selector	the selector to look up
+	 * @return the cached entry, or NULL if there is none
+	 */
+	const SelectorCacheEntry *getCachedSelector(reg_t objPos, Selector selector);
+
+	/** Stores the result of a selector lookup in the selector cache. */
+	void cacheSelector(reg_t objPos, Selector selector, const SelectorCacheEntry &entry);
+
+	/**
+	 * Empties the selector cache. This is needed whenever scripts are
+	 * loaded or unloaded, as object positions and superclass chains may
+	 * change then.
+	 */
+	void flushSelectorCache();
+
+	uint32 _selectorCacheHits; ///< Number of lookups answered by the selector cache
+	uint32 _selectorCacheMisses; ///< Number of lookups which had to scan the selector tables
+	uint32 _selectorCacheSaved; ///< Number of selector comparisons avoided by cache hits
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
 	/** Map script ids to segment ids. */
 	Common::HashMap<int, SegmentId> _scriptSegMap;
 
+	struct SelectorCacheKey {
+		reg_t objPos;
+		Selector selector;
+
+		bool operator==(const SelectorCacheKey &other) const {
+			return objPos == other.objPos && selector == other.selector;
+		}
+	};
+
+	struct SelectorCacheKey_Hash {
+		uint operator()(const SelectorCacheKey &key) const {
+			return ((key.objPos.segment << 16) | key.objPos.offset) ^ (key.selector * 2654435761U);
+		}
+	};
+
+	/** Results of lookupSelector(), keyed by base object position and selector */
+	Common::HashMap<SelectorCacheKey, SelectorCacheEntry, SelectorCacheKey_Hash> _selectorCache;
+
 	ResourceManager *_resMan;
 
 	SegmentId _clonesSegId; ///< ID of the (a) clones segment
@@ -247,6 +247,17 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	run_vm(s); // Start a new vm
 }
 
+static SelectorType fillSelectorLookup(const SegManager::SelectorCacheEntry &entry, reg_t obj_location, ObjVarRef *varp, reg_t *fptr) {
+	if (entry.type == kSelectorVariable && varp) {
+		varp->obj = obj_location;
+		varp->varindex = entry.varIndex;
+	} else if (entry.type == kSelectorMethod && fptr) {
+		*fptr = entry.funcAddr;
+	}
+
+	return entry.type;
+}
+
 SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
 	const Object *obj = segMan->getObject(obj_location);
 	int index;
@@ -262,34 +273,48 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 				PRINT_REG(obj_location));
 	}
 
-	index = obj->locateVarSelector(segMan, selectorId);
-
-	if (index >= 0) {
-		// Found it as a variable
-		if (varp) {
-			varp->obj = obj_location;
-			varp->varindex = index;
-		}
-		return kSelectorVariable;
-	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
+	// The lookup result only depends on the variable and method tables of
+	// the object and its superclasses. Clones share these with the object
+	// they were created from, which getPos() refers to, so we can cache
+	// the results for that position. The cache gets flushed whenever
+	// scripts are loaded or unloaded.
+	const reg_t objPos = obj->getPos();
+	const SegManager::SelectorCacheEntry *cached = segMan->getCachedSelector(objPos, selectorId);
+
+	if (!cached) {
+		SegManager::SelectorCacheEntry entry;
+		entry.type = kSelectorNone;
+		entry.varIndex = -1;
+		entry.funcAddr = NULL_REG;
+		entry.cost = obj->getVarCount();
+
+		index = obj->locateVarSelector(segMan, selectorId);
+
+		if (index >= 0) {
+			// Found it as a variable
+			entry.type = kSelectorVariable;
+			entry.varIndex = index;
+		} else {
+			// Check if it's a method, with recursive lookup in superclasses
+			const Object *curObj = obj;
+			while (curObj) {
+				index = curObj->funcSelectorPosition(selectorId);
+				entry.cost += curObj->getMethodCount();
+				if (index >= 0) {
+					entry.type = kSelectorMethod;
+					entry.funcAddr = curObj->getFunction(index);
+					break;
+				} else {
+					curObj = segMan->getObject(curObj->getSuperClassSelector());
+				}
 			}
 		}
 
-		return kSelectorNone;
+		segMan->cacheSelector(objPos, selectorId, entry);
+		return fillSelectorLookup(entry, obj_location, varp, fptr);
 	}
 
-
-//	return _lookupSelector_function(segMan, obj, selectorId, fptr);
+	return fillSelectorLookup(*cached, obj_location, varp, fptr);
 }
 
 } // End of namespace Sci
@@ -116,6 +116,12 @@ void EngineState::reset(bool isRestoring) {
 
 	_videoState.reset();
 	_syncedAudioOptions = false;
+
+	_pathfindingGraphs.clear();
+	_pathfindingCalls = 0;
+	_pathfindingMicros = 0;
+	_pathfindingGraphHits = 0;
+	_pathfindingGraphMisses = 0;
 }
 
 void EngineState::speedThrottler(uint32 neededSleep) {
@@ -131,6 +131,18 @@ struct VideoState {
 	}
 };
 
+/**
+ * Visibility between the vertices of one set of pathfinding obstacles. It is
+ * filled in lazily by kAvoidPath and reused for as long as the obstacles stay
+ * the same, so that only the start and end points need to be checked again.
+ */
+struct PathfindingGraph {
+	Common::Array<int16> obstacles; ///< Polygon sizes and points the graph was built for
+	Common::Array<byte> visibility; ///< vertexCount * vertexCount entries, see kpathing.cpp
+	uint vertexCount;
+	uint32 lastUse;
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -230,6 +242,12 @@ public:
 	VideoState _videoState;
 	bool _syncedAudioOptions;
 
+	Common::List<PathfindingGraph> _pathfindingGraphs; ///< Cached kAvoidPath visibility graphs
+	uint32 _pathfindingCalls; ///< Number of kAvoidPath path queries
+	uint32 _pathfindingMicros; ///< Total time spent in kAvoidPath path queries
+	uint32 _pathfindingGraphHits; ///< Vertex pairs taken from a cached graph
+	uint32 _pathfindingGraphMisses; ///< Vertex pairs that had to be checked
+
 	/**
 	 * Resets the engine state.
 	 */
@@ -22,6 +22,7 @@
 
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 
 #include "sci/sci.h"
 #include "sci/console.h"
@@ -543,6 +544,7 @@ int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4])
 
 void run_vm(EngineState *s) {
 	assert(s);
+	PROFILE_SCOPE("SCI run_vm");
 
 	int temp;
 	reg_t r_temp; // Temporary register
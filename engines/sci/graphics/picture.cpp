@@ -20,9 +20,10 @@
  *
  */
 
-#include "common/stack.h"
 #include "common/system.h"
 
+#include "graphics/primitives.h"
+
 #include "sci/sci.h"
 #include "sci/engine/state.h"
 #include "sci/graphics/screen.h"
@@ -859,21 +860,44 @@ void GfxPicture::vectorGetPatternTexture(byte *data, int &curPos, int16 pattern_
 	}
 }
 
-// WARNING: Do not replace the following code with something else, like generic
-// code. This algo really needs to behave exactly as the one from sierra.
+/**
+ * Filler for Graphics::floodFill, which fills the screens selected by the
+ * screen mask wherever the screen chosen by the match mask still has the
+ * color, priority or control that was found at the start of the fill.
+ *
+ * WARNING: The fill really needs to cover exactly the same pixels as the
+ * one from sierra. This relies on the pixel test staying isFillMatch()
+ * with the EGA visible color comparison, on the start point not being
+ * checked against the port, and on the fill being limited to the port
+ * rectangle otherwise.
+ */
+struct PictureFiller {
+	GfxScreen *screen;
+	byte screenMask, matchMask;
+	byte color, priority, control;
+	byte searchColor, searchPriority, searchControl;
+	bool isEGA;
+
+	bool isFillable(int x, int y) {
+		return screen->isFillMatch(x, y, matchMask, searchColor, searchPriority, searchControl, isEGA) != 0;
+	}
+
+	void fillSpan(int x1, int x2, int y) {
+		for (int x = x1; x <= x2; x++)
+			screen->putPixel(x, y, screenMask, color, priority, control);
+	}
+};
+
 void GfxPicture::vectorFloodFill(int16 x, int16 y, byte color, byte priority, byte control) {
 	Port *curPort = _ports->getPort();
-	Common::Stack<Common::Point> stack;
-	Common::Point p, p1;
+	Common::Point p;
 	byte screenMask = _screen->getDrawingMask(color, priority, control);
-	byte matchedMask, matchMask;
-	int16 w, e, a_set, b_set;
+	byte matchMask;
 
 	bool isEGA = (_resMan->getViewType() == kViewEga);
 
 	p.x = x + curPort->left;
 	p.y = y + curPort->top;
-	stack.push(p);
 
 	byte searchColor = _screen->getVisual(p.x, p.y);
 	byte searchPriority = _screen->getPriority(p.x, p.y);
@@ -923,48 +947,24 @@ void GfxPicture::vectorFloodFill(int16 x, int16 y, byte color, byte priority, by
 		matchMask = GFX_SCREEN_MASK_CONTROL;
 	}
 
+	PictureFiller filler;
+	filler.screen = _screen;
+	filler.screenMask = screenMask;
+	filler.matchMask = matchMask;
+	filler.color = color;
+	filler.priority = priority;
+	filler.control = control;
+	filler.searchColor = searchColor;
+	filler.searchPriority = searchPriority;
+	filler.searchControl = searchControl;
+	filler.isEGA = isEGA;
+
 	// hard borders for filling
 	int l = curPort->rect.left + curPort->left;
 	int t = curPort->rect.top + curPort->top;
 	int r = curPort->rect.right + curPort->left - 1;
 	int b = curPort->rect.bottom + curPort->top - 1;
-	while (stack.size()) {
-		p = stack.pop();
-		if ((matchedMask = _screen->isFillMatch(p.x, p.y, matchMask, searchColor, searchPriority, searchControl, isEGA)) == 0) // already filled
-			continue;
-		_screen->putPixel(p.x, p.y, screenMask, color, priority, control);
-		w = p.x;
-		e = p.x;
-		// moving west and east pointers as long as there is a matching color to fill
-		while (w > l && (matchedMask = _screen->isFillMatch(w - 1, p.y, matchMask, searchColor, searchPriority, searchControl, isEGA)))
-			_screen->putPixel(--w, p.y, screenMask, color, priority, control);
-		while (e < r && (matchedMask = _screen->isFillMatch(e + 1, p.y, matchMask, searchColor, searchPriority, searchControl, isEGA)))
-			_screen->putPixel(++e, p.y, screenMask, color, priority, control);
-		// checking lines above and below for possible flood targets
-		a_set = b_set = 0;
-		while (w <= e) {
-			if (p.y > t && (matchedMask = _screen->isFillMatch(w, p.y - 1, matchMask, searchColor, searchPriority, searchControl, isEGA))) { // one line above
-				if (a_set == 0) {
-					p1.x = w;
-					p1.y = p.y - 1;
-					stack.push(p1);
-					a_set = 1;
-				}
-			} else
-				a_set = 0;
-
-			if (p.y < b && (matchedMask = _screen->isFillMatch(w, p.y + 1, matchMask, searchColor, searchPriority, searchControl, isEGA))) { // one line below
-				if (b_set == 0) {
-					p1.x = w;
-					p1.y = p.y + 1;
-					stack.push(p1);
-					b_set = 1;
-				}
-			} else
-				b_set = 0;
-			w++;
-		}
-	}
+	Graphics::floodFill(p.x, p.y, l, t, r, b, filler);
 }
 
 // Bitmap for drawing sierra circles
@@ -56,6 +56,10 @@ void debugC(int channel, const char *s, ...) {
 ScummDebugger::ScummDebugger(ScummEngine *s)
 	: GUI::Debugger() {
 	_vm = s;
+#ifdef ENABLE_PERF_COUNTERS
+	_ipsOpcodes = 0;
+	_ipsTime = 0;
+#endif
 
 	// Register variables
 	DVar_Register("scumm_speed", &_vm->_fastMode, DVAR_BYTE, 0);
@@ -78,6 +82,9 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	DCmd_Register("script",    WRAP_METHOD(ScummDebugger, Cmd_Script));
 	DCmd_Register("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	DCmd_Register("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
+#ifdef ENABLE_PERF_COUNTERS
+	DCmd_Register("ips",       WRAP_METHOD(ScummDebugger, Cmd_Ips));
+#endif
 	DCmd_Register("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
 
 	if (_vm->_game.id == GID_LOOM)
@@ -860,6 +867,31 @@ bool ScummDebugger::Cmd_Passcode(int argc, const char **argv) {
 	return false;
 }
 
+#ifdef ENABLE_PERF_COUNTERS
+bool ScummDebugger::Cmd_Ips(int argc, const char **argv) {
+	const uint32 opcodes = _vm->_opcodeCounter;
+	const uint32 now = _vm->_system->getMillis();
+
+	DebugPrintf("%d opcodes executed (SCUMM v%d", opcodes, _vm->_game.version);
+	if (_vm->_game.heversion)
+		DebugPrintf(", HE %d", _vm->_game.heversion);
+	DebugPrintf(")\n");
+
+	if (_ipsTime && now > _ipsTime) {
+		const uint32 elapsed = now - _ipsTime;
+		const uint32 executed = opcodes - _ipsOpcodes;
+		DebugPrintf("%d opcodes in the last %d ms: %d instructions per second\n",
+			executed, elapsed, (int)((double)executed * 1000 / elapsed));
+	} else {
+		DebugPrintf("Run the game for a while, then use this command again to get the instructions per second\n");
+	}
+
+	_ipsOpcodes = opcodes;
+	_ipsTime = now;
+	return true;
+}
+#endif
+
 bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	_vm->resetCursors();
 	detach();
@@ -37,6 +37,11 @@ private:
 	ScummEngine *_vm;
 	bool  _old_soundsPaused;
 
+#ifdef ENABLE_PERF_COUNTERS
+	uint32 _ipsOpcodes;	///< Opcode counter at the last "ips" command
+	uint32 _ipsTime;	///< Time of the last "ips" command
+#endif
+
 	// Commands
 	bool Cmd_Room(int argc, const char **argv);
 	bool Cmd_LoadGame(int argc, const char **argv);
@@ -66,6 +71,9 @@ private:
 	bool Cmd_IMuse(int argc, const char **argv);
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
+#ifdef ENABLE_PERF_COUNTERS
+	bool Cmd_Ips(int argc, const char **argv);
+#endif
 
 	void printBox(int box);
 	void drawBox(int box);
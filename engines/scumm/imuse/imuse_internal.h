@@ -283,6 +283,7 @@ public:
 	void send(uint32 b);
 	void sysEx(const byte *msg, uint16 length);
 	void metaEvent(byte type, byte *data, uint16 length);
+	void setEventDelay(uint32 delay);
 };
 
 
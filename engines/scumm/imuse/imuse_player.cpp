@@ -1016,6 +1016,11 @@ void Player::metaEvent(byte type, byte *msg, uint16 len) {
 		clear();
 }
 
+void Player::setEventDelay(uint32 delay) {
+	if (_midi)
+		_midi->setEventDelay(delay);
+}
+
 
 
 ////////////////////////////////////////
@@ -177,7 +177,7 @@ bool ScummEngine::saveState(Common::OutSaveFile *out, bool writeHeader) {
 	return true;
 }
 
-bool ScummEngine::saveState(int slot, bool compat) {
+bool ScummEngine::saveState(int slot, bool compat, bool background) {
 	bool saveFailed;
 	Common::String filename;
 	Common::OutSaveFile *out;
@@ -190,7 +190,12 @@ bool ScummEngine::saveState(int slot, bool compat) {
 	} else {
 		filename = makeSavegameName(slot, compat);
 	}
-	if (!(out = _saveFileMan->openForSaving(filename)))
+	if (background)
+		out = _saveFileMan->openForSavingAsync(filename,
+			new Common::Functor2Mem<const Common::String &, bool, void, ScummEngine>(this, &ScummEngine::backgroundSaveWritten));
+	else
+		out = _saveFileMan->openForSaving(filename);
+	if (!out)
 		return false;
 
 	saveFailed = false;
@@ -213,6 +218,13 @@ bool ScummEngine::saveState(int slot, bool compat) {
 	return true;
 }
 
+void ScummEngine::backgroundSaveWritten(const Common::String &filename, bool success) {
+	// This may be called while events are polled, so the error is only
+	// displayed from the main loop
+	if (!success)
+		_failedBackgroundSave = filename;
+}
+
 
 void ScummEngine_v4::prepareSavegame() {
 	Common::MemoryWriteStreamDynamic *memStream;
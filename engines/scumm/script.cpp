@@ -21,6 +21,7 @@
  */
 
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -455,6 +456,7 @@ void ScummEngine::refreshScriptPointer() {
 
 /** Execute a script - Read opcode, and execute it from the table */
 void ScummEngine::executeScript() {
+	PROFILE_SCOPE("SCUMM executeScript");
 	int c;
 	while (_currentScript != 0xFF) {
 
@@ -481,7 +483,9 @@ void ScummEngine::executeScript() {
 		}
 
 		executeOpcode(_opcode);
-
+#ifdef ENABLE_PERF_COUNTERS
+		_opcodeCounter++;
+#endif
 	}
 }
 
@@ -528,6 +532,31 @@ int ScummEngine::fetchScriptDWordSigned() {
 	return (int32)fetchScriptDWord();
 }
 
+void ScummEngine::setupVarClasses() {
+	// Bit variables are stored in their own array, except for older games,
+	// which pack them into the regular variables. HE80+ games use the
+	// same bit for room variables instead.
+	VarClass bitClass;
+	if (_game.heversion >= 80)
+		bitClass = kVarClassRoom;
+	else if (_game.version <= 3 && !(_game.id == GID_INDY3 && _game.platform == Common::kPlatformFMTowns) &&
+		!(_game.id == GID_LOOM && _game.platform == Common::kPlatformPCEngine))
+		bitClass = kVarClassPackedBit;
+	else
+		bitClass = kVarClassBit;
+
+	for (int i = 0; i < 16; i++) {
+		if (i == 0)
+			_varClasses[i] = kVarClassGlobal;
+		else if (i & 8)
+			_varClasses[i] = bitClass;
+		else if (i & 4)
+			_varClasses[i] = kVarClassLocal;
+		else
+			_varClasses[i] = kVarClassIllegal;
+	}
+}
+
 int ScummEngine::readVar(uint var) {
 	int a;
 
@@ -542,7 +571,8 @@ int ScummEngine::readVar(uint var) {
 		var &= ~0x2000;
 	}
 
-	if (!(var & 0xF000)) {
+	switch (_varClasses[(var >> 12) & 0xF]) {
+	case kVarClassGlobal:
 		if (!_copyProtection) {
 			if (var == 490 && _game.id == GID_MONKEY2) {
 				var = 518;
@@ -558,42 +588,39 @@ int ScummEngine::readVar(uint var) {
 
 		assertRange(0, var, _numVariables - 1, "variable (reading)");
 		return _scummVars[var];
-	}
 
-	if (var & 0x8000) {
-		if (_game.heversion >= 80) {
-			var &= 0xFFF;
-			assertRange(0, var, _numRoomVariables - 1, "room variable (reading)");
-			return _roomVars[var];
-
-		} else if (_game.version <= 3 && !(_game.id == GID_INDY3 && _game.platform == Common::kPlatformFMTowns) &&
-			!(_game.id == GID_LOOM && _game.platform == Common::kPlatformPCEngine)) {
-			int bit = var & 0xF;
-			var = (var >> 4) & 0xFF;
-
-			if (!_copyProtection) {
-				if (_game.id == GID_LOOM && (_game.platform == Common::kPlatformFMTowns) && var == 214 && bit == 15) {
-					return 0;
-				} else if (_game.id == GID_ZAK && (_game.platform == Common::kPlatformFMTowns) && var == 151 && bit == 8) {
-					return 0;
-				}
-			}
+	case kVarClassRoom:
+		var &= 0xFFF;
+		assertRange(0, var, _numRoomVariables - 1, "room variable (reading)");
+		return _roomVars[var];
 
-			assertRange(0, var, _numVariables - 1, "variable (reading)");
-			return (_scummVars[ var ] & ( 1 << bit ) ) ? 1 : 0;
-		} else {
-			var &= 0x7FFF;
-			if (!_copyProtection) {
-				if (_game.id == GID_INDY3 && (_game.platform == Common::kPlatformFMTowns) && var == 1508)
-					return 0;
+	case kVarClassPackedBit: {
+		int bit = var & 0xF;
+		var = (var >> 4) & 0xFF;
+
+		if (!_copyProtection) {
+			if (_game.id == GID_LOOM && (_game.platform == Common::kPlatformFMTowns) && var == 214 && bit == 15) {
+				return 0;
+			} else if (_game.id == GID_ZAK && (_game.platform == Common::kPlatformFMTowns) && var == 151 && bit == 8) {
+				return 0;
 			}
+		}
 
-			assertRange(0, var, _numBitVariables - 1, "variable (reading)");
-			return (_bitVars[var >> 3] & (1 << (var & 7))) ? 1 : 0;
+		assertRange(0, var, _numVariables - 1, "variable (reading)");
+		return (_scummVars[ var ] & ( 1 << bit ) ) ? 1 : 0;
 		}
-	}
 
-	if (var & 0x4000) {
+	case kVarClassBit:
+		var &= 0x7FFF;
+		if (!_copyProtection) {
+			if (_game.id == GID_INDY3 && (_game.platform == Common::kPlatformFMTowns) && var == 1508)
+				return 0;
+		}
+
+		assertRange(0, var, _numBitVariables - 1, "variable (reading)");
+		return (_bitVars[var >> 3] & (1 << (var & 7))) ? 1 : 0;
+
+	case kVarClassLocal:
 		if (_game.features & GF_FEW_LOCALS) {
 			var &= 0xF;
 		} else {
@@ -605,6 +632,9 @@ int ScummEngine::readVar(uint var) {
 		else
 			assertRange(0, var, 20, "local variable (reading)");
 		return vm.localvar[_currentScript][var];
+
+	default:
+		break;
 	}
 
 	error("Illegal varbits (r)");
@@ -614,7 +644,8 @@ int ScummEngine::readVar(uint var) {
 void ScummEngine::writeVar(uint var, int value) {
 	debugC(DEBUG_VARS, "writeVar(%d, %d)", var, value);
 
-	if (!(var & 0xF000)) {
+	switch (_varClasses[(var >> 12) & 0xF]) {
+	case kVarClassGlobal:
 		assertRange(0, var, _numVariables - 1, "variable (writing)");
 
 		if (VAR_SUBTITLES != 0xFF && var == VAR_SUBTITLES) {
@@ -656,38 +687,37 @@ void ScummEngine::writeVar(uint var, int value) {
 							vm.slot[_currentScript].number);
 		}
 		return;
-	}
 
-	if (var & 0x8000) {
-		if (_game.heversion >= 80) {
-			var &= 0xFFF;
-			assertRange(0, var, _numRoomVariables - 1, "room variable (writing)");
-			_roomVars[var] = value;
-
-		} else if (_game.version <= 3 && !(_game.id == GID_INDY3 && _game.platform == Common::kPlatformFMTowns) &&
-			!(_game.id == GID_LOOM && _game.platform == Common::kPlatformPCEngine)) {
-			// In the old games, the bit variables were using the same memory
-			// as the normal variables!
-			int bit = var & 0xF;
-			var = (var >> 4) & 0xFF;
-			assertRange(0, var, _numVariables - 1, "variable (writing)");
-			if (value)
-				_scummVars[var] |= ( 1 << bit );
-			else
-				_scummVars[var] &= ~( 1 << bit );
-		} else {
-			var &= 0x7FFF;
-			assertRange(0, var, _numBitVariables - 1, "bit variable (writing)");
+	case kVarClassRoom:
+		var &= 0xFFF;
+		assertRange(0, var, _numRoomVariables - 1, "room variable (writing)");
+		_roomVars[var] = value;
+		return;
 
-			if (value)
-				_bitVars[var >> 3] |= (1 << (var & 7));
-			else
-				_bitVars[var >> 3] &= ~(1 << (var & 7));
+	case kVarClassPackedBit: {
+		// In the old games, the bit variables were using the same memory
+		// as the normal variables!
+		int bit = var & 0xF;
+		var = (var >> 4) & 0xFF;
+		assertRange(0, var, _numVariables - 1, "variable (writing)");
+		if (value)
+			_scummVars[var] |= ( 1 << bit );
+		else
+			_scummVars[var] &= ~( 1 << bit );
+		return;
 		}
+
+	case kVarClassBit:
+		var &= 0x7FFF;
+		assertRange(0, var, _numBitVariables - 1, "bit variable (writing)");
+
+		if (value)
+			_bitVars[var >> 3] |= (1 << (var & 7));
+		else
+			_bitVars[var >> 3] &= ~(1 << (var & 7));
 		return;
-	}
 
-	if (var & 0x4000) {
+	case kVarClassLocal:
 		if (_game.features & GF_FEW_LOCALS) {
 			var &= 0xF;
 		} else {
@@ -701,6 +731,9 @@ void ScummEngine::writeVar(uint var, int value) {
 
 		vm.localvar[_currentScript][var] = value;
 		return;
+
+	default:
+		break;
 	}
 
 	error("Illegal varbits (w)");
@@ -531,6 +531,9 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 
 	_hexdumpScripts = false;
 	_showStack = false;
+#ifdef ENABLE_PERF_COUNTERS
+	_opcodeCounter = 0;
+#endif
 
 	if (_game.platform == Common::kPlatformFMTowns && _game.version == 3) {	// FM-TOWNS V3 games use 320x240
 		_screenWidth = 320;
@@ -582,6 +585,9 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 
 
 ScummEngine::~ScummEngine() {
+	// Finish autosaves before their callback becomes invalid
+	_saveFileMan->flushAsyncSaves();
+
 	DebugMan.clearAllDebugChannels();
 
 	delete _musicEngine;
@@ -1265,6 +1271,7 @@ void ScummEngine::setupScumm() {
 	setupScummVars();
 
 	setupOpcodes();
+	setupVarClasses();
 
 	if (_game.version == 8)
 		_numActors = 80;
@@ -2066,6 +2073,12 @@ void ScummEngine::scummLoop(int delta) {
 		}
 	}
 
+	// Report an autosave which failed to be written in the background
+	if (!_failedBackgroundSave.empty()) {
+		displayMessage(0, _("Failed to save game state to file:\n\n%s"), _failedBackgroundSave.c_str());
+		_failedBackgroundSave.clear();
+	}
+
 	// Trigger autosave if necessary.
 	if (!_saveLoadFlag && shouldPerformAutoSave(_lastSaveTime) && canSaveGameStateCurrently()) {
 		_saveLoadSlot = 0;
@@ -2259,7 +2272,9 @@ void ScummEngine::scummLoop_handleSaveLoad() {
 			VAR(VAR_GAME_LOADED) = 0;
 
 		if (_saveLoadFlag == 1) {
-			success = saveState(_saveLoadSlot, _saveTemporaryState);
+			// Autosaves are written in the background, so that they don't
+			// interrupt the game
+			success = saveState(_saveLoadSlot, _saveTemporaryState, _saveLoadSlot == 0 && !_saveTemporaryState);
 			if (!success)
 				errMsg = _("Failed to save game state to file:\n\n%s");
 
@@ -574,9 +574,11 @@ protected:
 	bool _saveTemporaryState;
 	Common::String _saveLoadFileName;
 	Common::String _saveLoadDescription;
+	Common::String _failedBackgroundSave;	///< Savefile which couldn't be written in the background
 
 	bool saveState(Common::OutSaveFile *out, bool writeHeader = true);
-	bool saveState(int slot, bool compat);
+	bool saveState(int slot, bool compat, bool background = false);
+	void backgroundSaveWritten(const Common::String &filename, bool success);
 	bool loadState(int slot, bool compat);
 	virtual void saveOrLoad(Serializer *s);
 	void saveResource(Serializer *ser, ResType type, ResId idx);
@@ -624,10 +626,33 @@ protected:
 
 	OpcodeEntry _opcodes[256];
 
+#ifdef ENABLE_PERF_COUNTERS
+	/** Number of opcodes executed so far, shown by the debugger's "ips" command */
+	uint32 _opcodeCounter;
+#endif
+
 	virtual void setupOpcodes() = 0;
 	void executeOpcode(byte i);
 	const char *getOpcodeDesc(byte i);
 
+	/**
+	 * Storage classes of script variables. Which class a variable number
+	 * refers to depends on its top four bits and the game version.
+	 */
+	enum VarClass {
+		kVarClassGlobal,
+		kVarClassRoom,
+		kVarClassPackedBit,
+		kVarClassBit,
+		kVarClassLocal,
+		kVarClassIllegal
+	};
+
+	/** Variable class for each value of the top four bits of a variable number */
+	byte _varClasses[16];
+
+	void setupVarClasses();
+
 	void initializeLocals(int slot, int *vars);
 	int	getScriptSlot();
 
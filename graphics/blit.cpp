@@ -0,0 +1,372 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "graphics/blit.h"
+#include "graphics/pixelformat.h"
+
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/textconsole.h"
+
+namespace Graphics {
+
+void copyBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+              uint w, uint h, uint bytesPerPixel) {
+	if (dst == src || !w || !h)
+		return;
+
+	const uint rowSize = w * bytesPerPixel;
+
+	if (dstPitch == srcPitch && dstPitch == rowSize) {
+		memcpy(dst, src, rowSize * h);
+		return;
+	}
+
+	while (h--) {
+		memcpy(dst, src, rowSize);
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
+namespace {
+
+template<typename Pixel>
+void keyBlitRect(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+                 uint w, uint h, Pixel key) {
+	while (h--) {
+		const Pixel *s = (const Pixel *)src;
+		Pixel *d = (Pixel *)dst;
+
+		for (uint x = 0; x < w; x++) {
+			if (s[x] != key)
+				d[x] = s[x];
+		}
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
+void fillRow(uint16 *dst, uint w, uint16 color) {
+	// Write two pixels at a time, once the destination is aligned for it
+	if (w && ((size_t)dst & 2)) {
+		*dst++ = color;
+		w--;
+	}
+
+	uint32 *dst32 = (uint32 *)dst;
+	const uint32 pair = color | (color << 16);
+	for (uint n = w >> 1; n; n--)
+		*dst32++ = pair;
+
+	if (w & 1)
+		*(uint16 *)dst32 = color;
+}
+
+void fillRow(uint32 *dst, uint w, uint32 color) {
+	Common::set_to(dst, dst + w, color);
+}
+
+} // End of anonymous namespace
+
+void keyBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+             uint w, uint h, uint bytesPerPixel, uint32 key) {
+	if (bytesPerPixel == 1)
+		keyBlitRect<uint8>(dst, src, dstPitch, srcPitch, w, h, key);
+	else if (bytesPerPixel == 2)
+		keyBlitRect<uint16>(dst, src, dstPitch, srcPitch, w, h, key);
+	else if (bytesPerPixel == 4)
+		keyBlitRect<uint32>(dst, src, dstPitch, srcPitch, w, h, key);
+	else
+		error("keyBlit: bytesPerPixel must be 1, 2, or 4");
+}
+
+void fillBlit(byte *dst, uint pitch, uint w, uint h, uint bytesPerPixel, uint32 color) {
+	if (!w)
+		return;
+
+	// memset is as fast as it gets, so use it for colors made of equal bytes
+	if (bytesPerPixel == 1 ||
+	    (bytesPerPixel == 2 && (color & 0xFF) == ((color >> 8) & 0xFF)) ||
+	    (bytesPerPixel == 4 && color == (color & 0xFF) * 0x01010101)) {
+		const uint rowSize = w * bytesPerPixel;
+
+		if (pitch == rowSize) {
+			memset(dst, color & 0xFF, rowSize * h);
+			return;
+		}
+
+		while (h--) {
+			memset(dst, color & 0xFF, rowSize);
+			dst += pitch;
+		}
+	} else if (bytesPerPixel == 2) {
+		while (h--) {
+			fillRow((uint16 *)dst, w, color);
+			dst += pitch;
+		}
+	} else if (bytesPerPixel == 4) {
+		while (h--) {
+			fillRow((uint32 *)dst, w, color);
+			dst += pitch;
+		}
+	} else {
+		error("fillBlit: bytesPerPixel must be 1, 2, or 4");
+	}
+}
+
+namespace {
+
+template<typename Pixel>
+void clutBlitRect(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+                  uint w, uint h, const uint32 *map) {
+	while (h--) {
+		Pixel *d = (Pixel *)dst;
+
+		for (uint x = 0; x < w; x++)
+			d[x] = map[src[x]];
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
+} // End of anonymous namespace
+
+bool clutBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+              uint w, uint h, const byte *palette, const PixelFormat &dstFmt) {
+	if (dstFmt.bytesPerPixel != 2 && dstFmt.bytesPerPixel != 4)
+		return false;
+
+	uint32 map[256];
+	for (uint i = 0; i < 256; i++, palette += 3)
+		map[i] = dstFmt.RGBToColor(palette[0], palette[1], palette[2]);
+
+	if (dstFmt.bytesPerPixel == 2)
+		clutBlitRect<uint16>(dst, src, dstPitch, srcPitch, w, h, map);
+	else
+		clutBlitRect<uint32>(dst, src, dstPitch, srcPitch, w, h, map);
+
+	return true;
+}
+
+namespace {
+
+// The pixel formats with specialized conversions. Their layouts are
+// compile time constants, so that converting a pixel boils down to a
+// handful of shifts and masks.
+
+struct FormatRGB565 {
+	typedef uint16 Pixel;
+	enum { kRLoss = 3, kGLoss = 2, kBLoss = 3, kALoss = 8, kRShift = 11, kGShift = 5, kBShift = 0, kAShift = 0 };
+	static PixelFormat get() { return PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0); }
+};
+
+struct FormatRGB555 {
+	typedef uint16 Pixel;
+	enum { kRLoss = 3, kGLoss = 3, kBLoss = 3, kALoss = 8, kRShift = 10, kGShift = 5, kBShift = 0, kAShift = 0 };
+	static PixelFormat get() { return PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0); }
+};
+
+struct FormatXRGB8888 {
+	typedef uint32 Pixel;
+	enum { kRLoss = 0, kGLoss = 0, kBLoss = 0, kALoss = 8, kRShift = 16, kGShift = 8, kBShift = 0, kAShift = 0 };
+	static PixelFormat get() { return PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0); }
+};
+
+struct FormatARGB8888 {
+	typedef uint32 Pixel;
+	enum { kRLoss = 0, kGLoss = 0, kBLoss = 0, kALoss = 0, kRShift = 16, kGShift = 8, kBShift = 0, kAShift = 24 };
+	static PixelFormat get() { return PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24); }
+};
+
+struct FormatRGBA8888 {
+	typedef uint32 Pixel;
+	enum { kRLoss = 0, kGLoss = 0, kBLoss = 0, kALoss = 0, kRShift = 24, kGShift = 16, kBShift = 8, kAShift = 0 };
+	static PixelFormat get() { return PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0); }
+};
+
+// The same as PixelFormat::colorToARGB() followed by ARGBToColor()
+template<class Src, class Dst>
+inline typename Dst::Pixel convertPixel(uint32 color) {
+	const uint32 a = ((color >> Src::kAShift) << Src::kALoss) & 0xFF;
+	const uint32 r = ((color >> Src::kRShift) << Src::kRLoss) & 0xFF;
+	const uint32 g = ((color >> Src::kGShift) << Src::kGLoss) & 0xFF;
+	const uint32 b = ((color >> Src::kBShift) << Src::kBLoss) & 0xFF;
+
+	return ((a >> Dst::kALoss) << Dst::kAShift) |
+	       ((r >> Dst::kRLoss) << Dst::kRShift) |
+	       ((g >> Dst::kGLoss) << Dst::kGShift) |
+	       ((b >> Dst::kBLoss) << Dst::kBShift);
+}
+
+template<class Src, class Dst>
+void convertRect(byte *dst, const byte *src, uint dstPitch, uint srcPitch, uint w, uint h) {
+	while (h--) {
+		const typename Src::Pixel *s = (const typename Src::Pixel *)src;
+		typename Dst::Pixel *d = (typename Dst::Pixel *)dst;
+
+		for (uint x = 0; x < w; x++)
+			d[x] = convertPixel<Src, Dst>(s[x]);
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
+typedef void (*ConvertProc)(byte *, const byte *, uint, uint, uint, uint);
+
+template<class Src>
+ConvertProc findConverter(const PixelFormat &dstFmt) {
+	if (dstFmt == FormatRGB565::get())
+		return &convertRect<Src, FormatRGB565>;
+	if (dstFmt == FormatRGB555::get())
+		return &convertRect<Src, FormatRGB555>;
+	if (dstFmt == FormatXRGB8888::get())
+		return &convertRect<Src, FormatXRGB8888>;
+	if (dstFmt == FormatARGB8888::get())
+		return &convertRect<Src, FormatARGB8888>;
+	if (dstFmt == FormatRGBA8888::get())
+		return &convertRect<Src, FormatRGBA8888>;
+	return 0;
+}
+
+ConvertProc findConverter(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	if (srcFmt == FormatRGB565::get())
+		return findConverter<FormatRGB565>(dstFmt);
+	if (srcFmt == FormatRGB555::get())
+		return findConverter<FormatRGB555>(dstFmt);
+	if (srcFmt == FormatXRGB8888::get())
+		return findConverter<FormatXRGB8888>(dstFmt);
+	if (srcFmt == FormatARGB8888::get())
+		return findConverter<FormatARGB8888>(dstFmt);
+	if (srcFmt == FormatRGBA8888::get())
+		return findConverter<FormatRGBA8888>(dstFmt);
+	return 0;
+}
+
+} // End of anonymous namespace
+
+bool convertBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+                 uint w, uint h, const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	if (srcFmt == dstFmt) {
+		copyBlit(dst, src, dstPitch, srcPitch, w, h, dstFmt.bytesPerPixel);
+		return true;
+	}
+
+	ConvertProc convert = findConverter(dstFmt, srcFmt);
+	if (!convert)
+		return false;
+
+	convert(dst, src, dstPitch, srcPitch, w, h);
+	return true;
+}
+
+namespace {
+
+// Split the source pixels among the destination pixels; destination pixel i
+// covers the source pixels from start[i] up to end[i], and at least one
+void computeBoxes(Common::Array<uint> &start, Common::Array<uint> &end, uint dstSize, uint srcSize) {
+	start.resize(dstSize);
+	end.resize(dstSize);
+
+	for (uint i = 0; i < dstSize; i++) {
+		start[i] = MIN(i * srcSize / dstSize, srcSize - 1);
+		end[i] = MAX((i + 1) * srcSize / dstSize, start[i] + 1);
+	}
+}
+
+// Expand a row of source pixels to RGB triplets
+void decodeRow(byte *rgb, const byte *src, uint w, const PixelFormat &srcFmt, const byte *palette) {
+	if (srcFmt.bytesPerPixel == 1) {
+		for (uint x = 0; x < w; x++, rgb += 3)
+			memcpy(rgb, palette + src[x] * 3, 3);
+	} else if (srcFmt.bytesPerPixel == 2) {
+		const uint16 *s = (const uint16 *)src;
+		for (uint x = 0; x < w; x++, rgb += 3)
+			srcFmt.colorToRGB(s[x], rgb[0], rgb[1], rgb[2]);
+	} else {
+		const uint32 *s = (const uint32 *)src;
+		for (uint x = 0; x < w; x++, rgb += 3)
+			srcFmt.colorToRGB(s[x], rgb[0], rgb[1], rgb[2]);
+	}
+}
+
+} // End of anonymous namespace
+
+bool scaleBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+               uint dstW, uint dstH, uint srcW, uint srcH,
+               const PixelFormat &dstFmt, const PixelFormat &srcFmt, const byte *palette) {
+	if (dstFmt.bytesPerPixel != 2 && dstFmt.bytesPerPixel != 4)
+		return false;
+	if (srcFmt.bytesPerPixel == 1 ? !palette : (srcFmt.bytesPerPixel != 2 && srcFmt.bytesPerPixel != 4))
+		return false;
+	if (!dstW || !dstH || !srcW || !srcH)
+		return true;
+
+	Common::Array<uint> xStart, xEnd, yStart, yEnd;
+	computeBoxes(xStart, xEnd, dstW, srcW);
+	computeBoxes(yStart, yEnd, dstH, srcH);
+
+	// Every source row is decoded once per destination row it is part of,
+	// and summed up column by column
+	Common::Array<byte> rgb;
+	rgb.resize(srcW * 3);
+	Common::Array<uint32> sums;
+	sums.resize(dstW * 3);
+
+	for (uint y = 0; y < dstH; y++, dst += dstPitch) {
+		Common::set_to(sums.begin(), sums.end(), 0);
+
+		for (uint sy = yStart[y]; sy < yEnd[y]; sy++) {
+			decodeRow(rgb.begin(), src + sy * srcPitch, srcW, srcFmt, palette);
+
+			uint32 *sum = sums.begin();
+			for (uint x = 0; x < dstW; x++, sum += 3) {
+				const byte *c = rgb.begin() + xStart[x] * 3;
+				const byte *cEnd = rgb.begin() + xEnd[x] * 3;
+				for (; c != cEnd; c += 3) {
+					sum[0] += c[0];
+					sum[1] += c[1];
+					sum[2] += c[2];
+				}
+			}
+		}
+
+		const uint32 *sum = sums.begin();
+		for (uint x = 0; x < dstW; x++, sum += 3) {
+			const uint32 count = (xEnd[x] - xStart[x]) * (yEnd[y] - yStart[y]);
+			const uint32 color = dstFmt.RGBToColor((sum[0] + count / 2) / count,
+			                                       (sum[1] + count / 2) / count,
+			                                       (sum[2] + count / 2) / count);
+
+			if (dstFmt.bytesPerPixel == 2)
+				((uint16 *)dst)[x] = color;
+			else
+				((uint32 *)dst)[x] = color;
+		}
+	}
+
+	return true;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,134 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef GRAPHICS_BLIT_H
+#define GRAPHICS_BLIT_H
+
+#include "common/scummsys.h"
+
+namespace Graphics {
+
+struct PixelFormat;
+
+/**
+ * @defgroup blit Blitting and pixel format conversion
+ *
+ * Rectangle operations on raw pixel buffers, shared by the Surface methods,
+ * crossBlit() and engines which need to blit without the overhead of a
+ * Surface. All buffers are given by a pointer to their top left pixel and
+ * their pitch in bytes; 2 and 4 byte pixels must be naturally aligned.
+ *
+ * The operations work on whole rows in tight loops without per pixel
+ * branches or function calls, with the pixel formats baked in at compile
+ * time for the common format conversions, so that the compiler can unroll
+ * and vectorize them for the instruction set it targets.
+ * @{
+ */
+
+/**
+ * Copy a rectangle of pixels.
+ *
+ * @param dst           the top left pixel of the destination
+ * @param src           the top left pixel of the source
+ * @param dstPitch      the pitch of the destination in bytes
+ * @param srcPitch      the pitch of the source in bytes
+ * @param w             the width of the rectangle in pixels
+ * @param h             the height of the rectangle in pixels
+ * @param bytesPerPixel the size of a pixel in bytes
+ */
+void copyBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+              uint w, uint h, uint bytesPerPixel);
+
+/**
+ * Copy a rectangle of pixels, leaving the destination alone wherever the
+ * source has the transparent color.
+ *
+ * @param key           the transparent color
+ * @see copyBlit
+ */
+void keyBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+             uint w, uint h, uint bytesPerPixel, uint32 key);
+
+/**
+ * Fill a rectangle of pixels with a color.
+ *
+ * @param dst           the top left pixel of the rectangle
+ * @param pitch         the pitch of the buffer in bytes
+ * @param w             the width of the rectangle in pixels
+ * @param h             the height of the rectangle in pixels
+ * @param bytesPerPixel the size of a pixel in bytes; 1, 2 or 4
+ * @param color         the color to fill with
+ */
+void fillBlit(byte *dst, uint pitch, uint w, uint h, uint bytesPerPixel, uint32 color);
+
+/**
+ * Convert a rectangle of palette indices to a 2 or 4 byte pixel format.
+ *
+ * @param palette       the palette as 256 RGB triplets
+ * @param dstFmt        the pixel format of the destination
+ * @return              false if the destination format is not supported
+ * @see copyBlit
+ */
+bool clutBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+              uint w, uint h, const byte *palette, const PixelFormat &dstFmt);
+
+/**
+ * Convert a rectangle of pixels from one pixel format to another, if
+ * there is a specialized routine for the pair of formats. These are RGB565,
+ * RGB555, XRGB8888, ARGB8888 and RGBA8888, in all combinations. The
+ * result is the same as converting each pixel with colorToARGB() and
+ * ARGBToColor(). Converting in place works if both formats have the same
+ * size.
+ *
+ * @param dstFmt        the pixel format of the destination
+ * @param srcFmt        the pixel format of the source
+ * @return              false if there is no specialized routine for the
+ *                      formats, in which case nothing is converted
+ * @see copyBlit
+ */
+bool convertBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+                 uint w, uint h, const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+
+/**
+ * Scale a rectangle of pixels to another size, averaging the box of source
+ * pixels each destination pixel covers. Any ratio works, and it may differ
+ * between width and height; when scaling up, pixels are repeated.
+ *
+ * @param dstW          the width of the destination in pixels
+ * @param dstH          the height of the destination in pixels
+ * @param srcW          the width of the source in pixels
+ * @param srcH          the height of the source in pixels
+ * @param dstFmt        the pixel format of the destination; 2 or 4 bytes
+ * @param srcFmt        the pixel format of the source; 2 or 4 bytes, or
+ *                      CLUT8 together with a palette
+ * @param palette       the palette as 256 RGB triplets for a CLUT8 source
+ * @return              false if a format is not supported
+ * @see copyBlit
+ */
+bool scaleBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch,
+               uint dstW, uint dstH, uint srcW, uint srcH,
+               const PixelFormat &dstFmt, const PixelFormat &srcFmt, const byte *palette = 0);
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
@@ -20,6 +20,7 @@
  */
 
 #include "graphics/conversion.h"
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 
 namespace Graphics {
@@ -37,21 +38,14 @@ bool crossBlit(byte *dst, const byte *src, int dstpitch, int srcpitch,
 
 	// Don't perform unnecessary conversion
 	if (srcFmt == dstFmt) {
-		if (dst == src)
-			return true;
-		if (dstpitch == srcpitch && ((w * dstFmt.bytesPerPixel) == dstpitch)) {
-			memcpy(dst,src,dstpitch * h);
-			return true;
-		} else {
-			for (int i = 0; i < h; i++) {
-				memcpy(dst,src,w * dstFmt.bytesPerPixel);
-				dst += dstpitch;
-				src += srcpitch;
-			}
-			return true;
-		}
+		copyBlit(dst, src, dstpitch, srcpitch, w, h, dstFmt.bytesPerPixel);
+		return true;
 	}
 
+	// Use the specialized conversion for the common formats
+	if (convertBlit(dst, src, dstpitch, srcpitch, w, h, dstFmt, srcFmt))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	int srcDelta, dstDelta;
 	srcDelta = (srcpitch - w * srcFmt.bytesPerPixel);
@@ -119,7 +113,7 @@ bool crossBlit(byte *dst, const byte *src, int dstpitch, int srcpitch,
 			col++;
 #endif
 			for (int y = 0; y < h; y++) {
-				for (int x = 0; x < w; x++, src += 2, dst += 4) {
+				for (int x = 0; x < w; x++, src += 3, dst += 4) {
 					memcpy(col, src, 3);
 					srcFmt.colorToARGB(color, a, r, g, b);
 					color = dstFmt.ARGBToColor(a, r, g, b);
@@ -22,10 +22,40 @@
 #include "graphics/font.h"
 
 #include "common/array.h"
+#include "common/list.h"
+#include "common/profiler.h"
 #include "common/util.h"
 
 namespace Graphics {
 
+/** The most recent results of Font::wordWrapText(), most recently used first. */
+struct WordWrapCache {
+	enum {
+		kMaxEntries = 32
+	};
+
+	struct Entry {
+		Common::String str;
+		int maxWidth;
+		Common::Array<Common::String> lines;
+		int width;
+	};
+
+	Common::List<Entry> entries;
+	uint size;
+
+	WordWrapCache() : size(0) {}
+};
+
+Font::~Font() {
+	delete _wrapCache;
+}
+
+void Font::clearLayoutCache() const {
+	delete _wrapCache;
+	_wrapCache = 0;
+}
+
 int Font::getStringWidth(const Common::String &str) const {
 	int space = 0;
 
@@ -36,6 +66,7 @@ int Font::getStringWidth(const Common::String &str) const {
 
 void Font::drawString(Surface *dst, const Common::String &sOld, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) const {
 	assert(dst != 0);
+	PROFILE_SCOPE("Font drawString");
 	const int leftX = x, rightX = x + w;
 	uint i;
 	Common::String s = sOld;
@@ -134,6 +165,43 @@ struct WordWrapper {
 };
 
 int Font::wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines) const {
+	PROFILE_SCOPE("Font wordWrapText");
+
+	if (!_wrapCache)
+		_wrapCache = new WordWrapCache();
+
+	Common::List<WordWrapCache::Entry> &entries = _wrapCache->entries;
+
+	for (Common::List<WordWrapCache::Entry>::iterator i = entries.begin(); i != entries.end(); ++i) {
+		if (i->maxWidth != maxWidth || i->str != str)
+			continue;
+
+		if (i != entries.begin()) {
+			entries.push_front(*i);
+			entries.erase(i);
+		}
+
+		lines.push_back(entries.front().lines);
+		return entries.front().width;
+	}
+
+	WordWrapCache::Entry entry;
+	entry.str = str;
+	entry.maxWidth = maxWidth;
+	entry.width = wordWrapTextIntern(str, maxWidth, entry.lines);
+
+	lines.push_back(entry.lines);
+
+	entries.push_front(entry);
+	if (_wrapCache->size == WordWrapCache::kMaxEntries)
+		entries.pop_back();
+	else
+		_wrapCache->size++;
+
+	return entry.width;
+}
+
+int Font::wordWrapTextIntern(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines) const {
 	WordWrapper wrapper(lines);
 	Common::String line;
 	Common::String tmpStr;
@@ -31,6 +31,7 @@ template<class T> class Array;
 namespace Graphics {
 
 struct Surface;
+struct WordWrapCache;
 
 /** Text alignment modes */
 enum TextAlign {
@@ -47,8 +48,8 @@ enum TextAlign {
  */
 class Font {
 public:
-	Font() {}
-	virtual ~Font() {}
+	Font() : _wrapCache(0) {}
+	virtual ~Font();
 
 	/**
 	 * Query the height of the font.
@@ -105,12 +106,27 @@ public:
 	 * It returns the maximal width of any of the new lines (i.e. a value which is less
 	 * or equal to maxWidth).
 	 *
+	 * The results of the most recent calls are cached, as the GUI wraps the
+	 * same texts over and over again when redrawing its dialogs.
+	 *
 	 * @param str      the string to word wrap
 	 * @param maxWidth the maximum width a line may have
 	 * @param lines    the string list to which the text lines from str are appended
 	 * @return the maximal width of any of the lines added to lines
 	 */
 	int wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines) const;
+
+protected:
+	/**
+	 * Forget all cached text layouts. Fonts have to call this whenever the
+	 * width of any of their characters changes.
+	 */
+	void clearLayoutCache() const;
+
+private:
+	mutable WordWrapCache *_wrapCache;
+
+	int wordWrapTextIntern(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines) const;
 };
 
 } // End of namespace Graphics
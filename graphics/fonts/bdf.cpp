@@ -57,33 +57,11 @@ int BdfFont::getCharWidth(byte chr) const {
 }
 
 
-template<typename PixelType>
-void drawCharIntern(byte *ptr, uint pitch, const bitmap_t *src, int h, int minX, int maxX, const PixelType color) {
-	const bitmap_t maxXMask = ~((1 << (16 - maxX)) - 1);
-	while (h-- > 0) {
-		bitmap_t buffer = READ_UINT16(src);
-		src++;
-
-		buffer &= maxXMask;
-		buffer <<= minX;
-		PixelType *tmp = (PixelType *)ptr;
-		while (buffer != 0) {
-			if ((buffer & 0x8000) != 0)
-				*tmp = color;
-			tmp++;
-			buffer <<= 1;
-		}
-
-		ptr += pitch;
-	}
-}
-
 void BdfFont::drawChar(Surface *dst, byte chr, const int tx, const int ty, const uint32 color) const {
 	assert(dst != 0);
 
 	// asserting _desc.maxwidth <= 50: let the theme designer decide what looks best
 	assert(_desc.bits != 0 && _desc.maxwidth <= 50);
-	assert(dst->format.bytesPerPixel == 1 || dst->format.bytesPerPixel == 2);
 
 	// If this character is not included in the font, use the default char.
 	if (chr < _desc.firstchar || chr >= _desc.firstchar + _desc.size) {
@@ -107,18 +85,29 @@ void BdfFont::drawChar(Surface *dst, byte chr, const int tx, const int ty, const
 		bby = _desc.bbx[chr].y;
 	}
 
-	byte *ptr = (byte *)dst->getBasePtr(tx + bbx, ty + _desc.ascent - bby - bbh);
+	if (!_atlas.hasGlyph(chr))
+		addGlyph(chr, bbw, bbh);
 
-	const bitmap_t *tmp = _desc.bits + (_desc.offset ? _desc.offset[chr] : (chr * _desc.fbbh));
+	_atlas.drawGlyph(dst, chr, tx + bbx, ty + _desc.ascent - bby - bbh, color);
+}
 
-	int y = MIN(bbh, ty + _desc.ascent - bby);
-	tmp += bbh - y;
-	y -= MAX(0, ty + _desc.ascent - bby - dst->h);
+void BdfFont::addGlyph(byte chr, int bbw, int bbh) const {
+	const bitmap_t *src = _desc.bits + (_desc.offset ? _desc.offset[chr] : (chr * _desc.fbbh));
+	const int words = (bbw + 15) / 16;
+
+	byte mask[50 * 50];
+	assert(bbw <= 50 && bbh <= 50);
+
+	for (int y = 0; y < bbh; y++) {
+		for (int x = 0; x < bbw; x++) {
+			const bitmap_t bits = READ_UINT16(src + x / 16);
+			mask[y * bbw + x] = (bits & (0x8000 >> (x % 16))) != 0;
+		}
+
+		src += words;
+	}
 
-	if (dst->format.bytesPerPixel == 1)
-		drawCharIntern<byte>(ptr, dst->pitch, tmp, y, MAX(0, -(tx + bbx)), MIN(bbw, dst->w - tx - bbx), color);
-	else if (dst->format.bytesPerPixel == 2)
-		drawCharIntern<uint16>(ptr, dst->pitch, tmp, y, MAX(0, -(tx + bbx)), MIN(bbw, dst->w - tx - bbx), color);
+	_atlas.addGlyph(chr, mask, bbw, bbh, bbw);
 }
 
 
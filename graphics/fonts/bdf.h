@@ -25,6 +25,7 @@
 #include "common/system.h"
 
 #include "graphics/font.h"
+#include "graphics/fonts/glyphatlas.h"
 
 namespace Common {
 class SeekableReadStream;
@@ -66,6 +67,11 @@ protected:
 	BdfFontDesc _desc;
 	BdfFontData *_font;
 
+	/** The glyphs drawn so far, expanded on first use */
+	mutable GlyphAtlas _atlas;
+
+	void addGlyph(byte chr, int bbw, int bbh) const;
+
 public:
 	BdfFont(const BdfFontDesc &desc, BdfFontData *font = 0) : _desc(desc), _font(font) {}
 	~BdfFont();
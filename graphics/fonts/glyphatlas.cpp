@@ -0,0 +1,158 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include "graphics/fonts/glyphatlas.h"
+#include "graphics/surface.h"
+
+#include "common/textconsole.h"
+#include "common/util.h"
+
+namespace Graphics {
+
+GlyphAtlas::GlyphAtlas() {
+	clear();
+}
+
+void GlyphAtlas::clear() {
+	_glyphs.clear();
+	_spans.clear();
+	_rowStarts.clear();
+	_highIndex.clear();
+
+	for (int i = 0; i < ARRAYSIZE(_lowIndex); i++)
+		_lowIndex[i] = -1;
+}
+
+const GlyphAtlas::Glyph *GlyphAtlas::findGlyph(uint32 id) const {
+	if (id < ARRAYSIZE(_lowIndex)) {
+		if (_lowIndex[id] < 0)
+			return 0;
+		return &_glyphs[_lowIndex[id]];
+	}
+
+	Common::HashMap<uint32, uint32>::const_iterator i = _highIndex.find(id);
+	if (i == _highIndex.end())
+		return 0;
+	return &_glyphs[i->_value];
+}
+
+void GlyphAtlas::addGlyph(uint32 id, const byte *mask, int w, int h, int pitch) {
+	assert(w >= 0 && w <= 0xFFFF && h >= 0);
+
+	Glyph glyph;
+	glyph.w = w;
+	glyph.h = h;
+	glyph.firstRow = _rowStarts.size();
+
+	for (int y = 0; y < h; y++) {
+		_rowStarts.push_back(_spans.size());
+
+		const byte *row = mask + y * pitch;
+		int x = 0;
+
+		while (x < w) {
+			if (!row[x]) {
+				x++;
+				continue;
+			}
+
+			Span span;
+			span.x = x;
+			while (x < w && row[x])
+				x++;
+			span.len = x - span.x;
+
+			_spans.push_back(span);
+		}
+	}
+
+	_rowStarts.push_back(_spans.size());
+
+	if (id < ARRAYSIZE(_lowIndex))
+		_lowIndex[id] = _glyphs.size();
+	else
+		_highIndex[id] = _glyphs.size();
+
+	_glyphs.push_back(glyph);
+}
+
+template<typename PixelType>
+void GlyphAtlas::drawSpans(byte *dst, int pitch, const Glyph &glyph, int minY, int maxY, int minX, int maxX, uint32 color) const {
+	const PixelType c = color;
+
+	for (int y = minY; y < maxY; y++) {
+		PixelType *row = (PixelType *)(dst + y * pitch);
+
+		const Span *span = _spans.begin() + _rowStarts[glyph.firstRow + y];
+		const Span *end = _spans.begin() + _rowStarts[glyph.firstRow + y + 1];
+
+		for (; span != end; ++span) {
+			const int left = MAX<int>(span->x, minX);
+			const int right = MIN<int>(span->x + span->len, maxX);
+
+			for (int x = left; x < right; x++)
+				row[x] = c;
+		}
+	}
+}
+
+void GlyphAtlas::drawSpans(byte *dst, int pitch, int bpp, const Glyph &glyph, int minY, int maxY, int minX, int maxX, uint32 color) const {
+	if (bpp == 1)
+		drawSpans<byte>(dst, pitch, glyph, minY, maxY, minX, maxX, color);
+	else if (bpp == 2)
+		drawSpans<uint16>(dst, pitch, glyph, minY, maxY, minX, maxX, color);
+	else if (bpp == 4)
+		drawSpans<uint32>(dst, pitch, glyph, minY, maxY, minX, maxX, color);
+	else
+		error("GlyphAtlas::drawGlyph: unsupported bpp: %d", bpp);
+}
+
+void GlyphAtlas::drawGlyph(Surface *dst, uint32 id, int x, int y, uint32 color) const {
+	assert(dst != 0);
+
+	const Glyph *glyph = findGlyph(id);
+	if (!glyph)
+		return;
+
+	const int minX = MAX(0, -x);
+	const int maxX = MIN<int>(glyph->w, dst->w - x);
+	const int minY = MAX(0, -y);
+	const int maxY = MIN<int>(glyph->h, dst->h - y);
+
+	if (minX >= maxX || minY >= maxY)
+		return;
+
+	// Address the top left edge of the glyph, even if it lies outside of
+	// the surface, so that the spans can be drawn at their own offsets.
+	byte *origin = (byte *)dst->pixels + y * dst->pitch + x * dst->format.bytesPerPixel;
+	drawSpans(origin, dst->pitch, dst->format.bytesPerPixel, *glyph, minY, maxY, minX, maxX, color);
+}
+
+void GlyphAtlas::drawGlyph(byte *dst, int pitch, int bpp, uint32 id, uint32 color) const {
+	const Glyph *glyph = findGlyph(id);
+	if (!glyph)
+		return;
+
+	drawSpans(dst, pitch, bpp, *glyph, 0, glyph->h, 0, glyph->w, color);
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef GRAPHICS_FONTS_GLYPHATLAS_H
+#define GRAPHICS_FONTS_GLYPHATLAS_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+
+namespace Graphics {
+
+struct Surface;
+
+/**
+ * Pre-expanded glyphs of a monochrome font.
+ *
+ * Every glyph is stored as the horizontal runs of set pixels of each of its
+ * rows, so drawing a glyph only fills those runs with the text color
+ * instead of testing every bit of the font bitmap. As the color changes
+ * from call to call, the runs don't depend on the pixel format; drawing
+ * them is specialized for 1, 2 and 4 bytes per pixel.
+ *
+ * Glyphs are identified by an arbitrary id chosen by the font, e.g. the
+ * character code. Ids below 256 are looked up in a table, all others in
+ * a hash map.
+ */
+class GlyphAtlas {
+public:
+	GlyphAtlas();
+
+	/** Remove all glyphs. */
+	void clear();
+
+	/** Return whether a glyph with the given id was added. */
+	bool hasGlyph(uint32 id) const { return findGlyph(id) != 0; }
+
+	/**
+	 * Add a glyph. An existing glyph with the same id is replaced.
+	 *
+	 * @param id    the id of the glyph
+	 * @param mask  the glyph as one byte per pixel, non-zero for set pixels
+	 * @param w     the width of the glyph
+	 * @param h     the height of the glyph
+	 * @param pitch the size of a row of mask in bytes
+	 */
+	void addGlyph(uint32 id, const byte *mask, int w, int h, int pitch);
+
+	/**
+	 * Draw a glyph on a surface, clipped to the surface. The point is the
+	 * top left edge of the glyph. Unknown glyphs are not drawn.
+	 */
+	void drawGlyph(Surface *dst, uint32 id, int x, int y, uint32 color) const;
+
+	/**
+	 * Draw a glyph on a raw buffer without any clipping.
+	 *
+	 * @param dst   pointer to where the top left edge of the glyph goes
+	 * @param pitch pitch of the destination buffer in bytes
+	 * @param bpp   bytes per pixel of the destination buffer
+	 */
+	void drawGlyph(byte *dst, int pitch, int bpp, uint32 id, uint32 color) const;
+
+	/** Return the number of glyphs. */
+	uint getGlyphCount() const { return _glyphs.size(); }
+
+private:
+	struct Span {
+		uint16 x;
+		uint16 len;
+	};
+
+	struct Glyph {
+		int16 w, h;
+		uint32 firstRow; ///< Index of the first row in _rowStarts
+	};
+
+	Common::Array<Glyph> _glyphs;
+	Common::Array<Span> _spans;
+	/** Index of the first span of each row, followed by the end of the last row of each glyph. */
+	Common::Array<uint32> _rowStarts;
+
+	int32 _lowIndex[256];
+	Common::HashMap<uint32, uint32> _highIndex;
+
+	const Glyph *findGlyph(uint32 id) const;
+
+	template<typename PixelType>
+	void drawSpans(byte *dst, int pitch, const Glyph &glyph, int minY, int maxY, int minX, int maxX, uint32 color) const;
+	void drawSpans(byte *dst, int pitch, int bpp, const Glyph &glyph, int minY, int maxY, int minX, int maxX, uint32 color) const;
+};
+
+} // End of namespace Graphics
+
+#endif
@@ -48,6 +48,8 @@ void WinFont::close() {
 	_glyphCount = 0;
 	delete[] _glyphs;
 	_glyphs = 0;
+	_atlas.clear();
+	clearLayoutCache();
 }
 
 // Reads a null-terminated string
@@ -319,6 +321,8 @@ bool WinFont::loadFromFNT(Common::SeekableReadStream &stream) {
 			debugN("\n");
 		}
 #endif
+
+		_atlas.addGlyph(i, _glyphs[i].bitmap, _glyphs[i].charWidth, _pixHeight, _glyphs[i].charWidth);
 	}
 
 	return true;
@@ -329,20 +333,7 @@ void WinFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const
 	assert(dst->format.bytesPerPixel == 1 || dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(_glyphs);
 
-	GlyphEntry &glyph = _glyphs[characterToIndex(chr)];
-
-	for (uint16 i = 0; i < _pixHeight; i++) {
-		for (uint16 j = 0; j < glyph.charWidth; j++) {
-			if (glyph.bitmap[j + i * glyph.charWidth]) {
-				if (dst->format.bytesPerPixel == 1)
-					*((byte *)dst->getBasePtr(x + j, y + i)) = color;
-				else if (dst->format.bytesPerPixel == 2)
-					*((uint16 *)dst->getBasePtr(x + j, y + i)) = color;
-				else if (dst->format.bytesPerPixel == 4)
-					*((uint32 *)dst->getBasePtr(x + j, y + i)) = color;
-			}
-		}
-	}
+	_atlas.drawGlyph(dst, characterToIndex(chr), x, y, color);
 }
 
 } // End of namespace Graphics
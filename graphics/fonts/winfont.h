@@ -24,6 +24,7 @@
 
 #include "common/str.h"
 #include "graphics/font.h"
+#include "graphics/fonts/glyphatlas.h"
 
 namespace Common {
 class SeekableReadStream;
@@ -89,6 +90,9 @@ private:
 		uint32 offset;
 		byte *bitmap;
 	} *_glyphs;
+
+	/** The glyph bitmaps, expanded into spans for drawing */
+	GlyphAtlas _atlas;
 };
 
 } // End of namespace Graphics
@@ -1,6 +1,7 @@
 MODULE := graphics
 
 MODULE_OBJS := \
+	blit.o \
 	conversion.o \
 	cursorman.o \
 	dither.o \
@@ -8,6 +9,7 @@ MODULE_OBJS := \
 	fontman.o \
 	fonts/bdf.o \
 	fonts/consolefont.o \
+	fonts/glyphatlas.o \
 	fonts/newfont_big.o \
 	fonts/newfont.o \
 	fonts/winfont.o \
@@ -22,11 +22,72 @@
 #ifndef GRAPHICS_PRIMITIVES_H
 #define GRAPHICS_PRIMITIVES_H
 
+#include "common/rect.h"
+#include "common/stack.h"
+
 namespace Graphics {
 
 void drawLine(int x0, int y0, int x1, int y1, int color, void (*plotProc)(int, int, int, void *), void *data);
 void drawThickLine(int x0, int y0, int x1, int y1, int thickness, int color, void (*plotProc)(int, int, int, void *), void *data);
 
+/**
+ * Scanline flood fill. Fills all pixels 4-connected to (x, y) that the
+ * filler accepts, one horizontal span at a time.
+ *
+ * The filler must provide two methods:
+ *  - bool isFillable(int x, int y): whether the pixel is to be filled
+ *  - void fillSpan(int x1, int x2, int y): fills the pixels x1 to x2 of row y
+ *
+ * A pixel must not be fillable anymore once it has been filled. The fill
+ * is limited to the rectangle from (left, top) to (right, bottom), with
+ * all borders inclusive: spans only grow, and the fill only moves up or
+ * down, while inside it. The start point itself is not checked against
+ * the rectangle, just like in Sierra's SCI fill; a fill starting outside
+ * spreads into the rectangle from there. Fillers whose pixels outside it
+ * are not fillable don't need to care. As a template, the pixel tests get
+ * inlined, which matters since they are done several times for each pixel.
+ */
+template<class Filler>
+void floodFill(int x, int y, int left, int top, int right, int bottom, Filler &filler) {
+	Common::Stack<Common::Point> stack;
+	stack.push(Common::Point(x, y));
+
+	while (!stack.empty()) {
+		const Common::Point p = stack.pop();
+
+		if (!filler.isFillable(p.x, p.y))
+			continue;
+
+		int x1 = p.x;
+		int x2 = p.x;
+		while (x1 > left && filler.isFillable(x1 - 1, p.y))
+			x1--;
+		while (x2 < right && filler.isFillable(x2 + 1, p.y))
+			x2++;
+
+		filler.fillSpan(x1, x2, p.y);
+
+		// Add one seed for each run of fillable pixels in the rows above
+		// and below the span
+		for (int row = p.y - 1; row <= p.y + 1; row += 2) {
+			if ((row < p.y && p.y <= top) || (row > p.y && p.y >= bottom))
+				continue;
+
+			bool newSpan = true;
+			for (int i = x1; i <= x2; i++) {
+				if (filler.isFillable(i, row)) {
+					if (newSpan) {
+						stack.push(Common::Point(i, row));
+						newSpan = false;
+					}
+				} else {
+					newSpan = true;
+				}
+			}
+		}
+	}
+}
+
 }	// End of namespace Graphics
 
 #endif
@@ -182,6 +182,77 @@ void FontSJISBase::createOutline(uint8 *outline, const uint8 *glyph, const int w
 	}
 }
 
+void FontSJISBase::expandCharacter(const uint8 *glyph, const int w, const int h, uint8 *mask) const {
+	// This has to match blitCharacter
+	uint8 bitPos = 0;
+	uint8 bits = 0;
+
+	for (int y = 0; y < h; ++y) {
+		bitPos &= _bitPosNewLineMask;
+		for (int x = 0; x < w; ++x) {
+			if (!(bitPos % 8))
+				bits = *glyph++;
+
+			*mask++ = (bits & 0x80) ? 1 : 0;
+
+			++bitPos;
+			bits <<= 1;
+		}
+	}
+}
+
+void FontSJISBase::addAtlasGlyph(uint32 id, const uint8 *glyph, const int w, const int h) const {
+	uint8 mask[18 * 18];
+
+	if (id & kAtlasOutline) {
+		uint8 outline[18 * 18];
+		memset(outline, 0, sizeof(outline));
+		createOutline(outline, glyph, w, h);
+
+		expandCharacter(outline, w + 2, h + 2, mask);
+		_atlas.addGlyph(id, mask, w + 2, h + 2, w + 2);
+	} else {
+		expandCharacter(glyph, w, h, mask);
+		_atlas.addGlyph(id, mask, w, h, w);
+	}
+}
+
+void FontSJISBase::drawAtlasChar(uint8 *dst, uint16 ch, int pitch, int bpp, int width, int height, uint32 c1, uint32 c2) const {
+	uint32 glyphId = ch;
+#ifndef DISABLE_FLIPPED_MODE
+	if (_flippedMode)
+		glyphId |= kAtlasFlipped;
+#endif
+	const uint32 outlineId = glyphId | kAtlasOutline;
+
+	if (!_atlas.hasGlyph(glyphId) || (_drawMode == kOutlineMode && !_atlas.hasGlyph(outlineId))) {
+		const uint8 *glyphSource = getCharData(ch);
+#ifndef DISABLE_FLIPPED_MODE
+		if (_flippedMode)
+			glyphSource = flipCharacter(glyphSource, width);
+#endif
+
+		if (!_atlas.hasGlyph(glyphId))
+			addAtlasGlyph(glyphId, glyphSource, width, height);
+		if (_drawMode == kOutlineMode && !_atlas.hasGlyph(outlineId))
+			addAtlasGlyph(outlineId, glyphSource, width, height);
+	}
+
+	if (_drawMode == kOutlineMode) {
+		_atlas.drawGlyph(dst, pitch, bpp, outlineId, c2);
+		_atlas.drawGlyph(dst + pitch + bpp, pitch, bpp, glyphId, c1);
+	} else {
+		if (_drawMode != kDefaultMode) {
+			_atlas.drawGlyph(dst + bpp, pitch, bpp, glyphId, c2);
+			_atlas.drawGlyph(dst + pitch, pitch, bpp, glyphId, c2);
+			if (_drawMode == kShadowMode)
+				_atlas.drawGlyph(dst + pitch + bpp, pitch, bpp, glyphId, c2);
+		}
+
+		_atlas.drawGlyph(dst, pitch, bpp, glyphId, c1);
+	}
+}
+
 #ifndef DISABLE_FLIPPED_MODE
 const uint8 *FontSJISBase::flipCharacter(const uint8 *glyph, const int w) const {
 	static const uint8 flipData[] = {
@@ -248,6 +319,13 @@ void FontSJISBase::drawChar(void *dst, uint16 ch, int pitch, int bpp, uint32 c1,
 		return;
 	}
 
+	// Unclipped characters are drawn from the glyph atlas, clipped ones
+	// are rare enough to be drawn directly from the font data.
+	if (!outlineXOffset && !outlineYOffset && (bpp == 1 || bpp == 2)) {
+		drawAtlasChar((uint8 *)dst, ch, pitch, bpp, width, height, c1, c2);
+		return;
+	}
+
 #ifndef DISABLE_FLIPPED_MODE
 	if (_flippedMode)
 		glyphSource = flipCharacter(glyphSource, width);
@@ -43,6 +43,8 @@
 #endif
 
 #include "common/scummsys.h"
+
+#include "graphics/fonts/glyphatlas.h"
 #include "common/util.h"
 
 namespace Graphics {
@@ -158,6 +160,22 @@ private:
 	void blitCharacter(const uint8 *glyph, const int w, const int h, uint8 *dst, int pitch, Color c) const;
 	void createOutline(uint8 *outline, const uint8 *glyph, const int w, const int h) const;
 
+	enum {
+		kAtlasFlipped = 1 << 16,
+		kAtlasOutline = 1 << 17
+	};
+
+	/**
+	 * The glyphs drawn so far, expanded on first use. Glyphs are identified
+	 * by their character, combined with kAtlasFlipped and kAtlasOutline for
+	 * flipped and outline variants.
+	 */
+	mutable GlyphAtlas _atlas;
+
+	void expandCharacter(const uint8 *glyph, const int w, const int h, uint8 *mask) const;
+	void addAtlasGlyph(uint32 id, const uint8 *glyph, const int w, const int h) const;
+	void drawAtlasChar(uint8 *dst, uint16 ch, int pitch, int bpp, int width, int height, uint32 c1, uint32 c2) const;
+
 #ifndef DISABLE_FLIPPED_MODE
 	// This is used in the FM-Towns version of Monkey Island 1
 	// when Guybrush gets shot out of the cannon in the circus tent.
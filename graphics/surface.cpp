@@ -23,6 +23,7 @@
 #include "common/util.h"
 #include "common/rect.h"
 #include "common/textconsole.h"
+#include "graphics/blit.h"
 #include "graphics/primitives.h"
 #include "graphics/surface.h"
 
@@ -90,18 +91,10 @@ void Surface::hLine(int x, int y, int x2, uint32 color) {
 	if (x2 < x)
 		return;
 
-	if (format.bytesPerPixel == 1) {
-		byte *ptr = (byte *)getBasePtr(x, y);
-		memset(ptr, (byte)color, x2 - x + 1);
-	} else if (format.bytesPerPixel == 2) {
-		uint16 *ptr = (uint16 *)getBasePtr(x, y);
-		Common::set_to(ptr, ptr + (x2 - x + 1), (uint16)color);
-	} else if (format.bytesPerPixel == 4) {
-		uint32 *ptr = (uint32 *)getBasePtr(x, y);
-		Common::set_to(ptr, ptr + (x2 - x + 1), color);
-	} else {
+	if (format.bytesPerPixel != 1 && format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
 		error("Surface::hLine: bytesPerPixel must be 1, 2, or 4");
-	}
+
+	fillBlit((byte *)getBasePtr(x, y), pitch, x2 - x + 1, 1, format.bytesPerPixel, color);
 }
 
 void Surface::vLine(int x, int y, int y2, uint32 color) {
@@ -147,42 +140,10 @@ void Surface::fillRect(Common::Rect r, uint32 color) {
 	if (!r.isValidRect())
 		return;
 
-	int width = r.width();
-	int lineLen = width;
-	int height = r.height();
-	bool useMemset = true;
-
-	if (format.bytesPerPixel == 2) {
-		lineLen *= 2;
-		if ((uint16)color != ((color & 0xff) | (color & 0xff) << 8))
-			useMemset = false;
-	} else if (format.bytesPerPixel == 4) {
-		useMemset = false;
-	} else if (format.bytesPerPixel != 1) {
+	if (format.bytesPerPixel != 1 && format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
 		error("Surface::fillRect: bytesPerPixel must be 1, 2, or 4");
-	}
 
-	if (useMemset) {
-		byte *ptr = (byte *)getBasePtr(r.left, r.top);
-		while (height--) {
-			memset(ptr, (byte)color, lineLen);
-			ptr += pitch;
-		}
-	} else {
-		if (format.bytesPerPixel == 2) {
-			uint16 *ptr = (uint16 *)getBasePtr(r.left, r.top);
-			while (height--) {
-				Common::set_to(ptr, ptr + width, (uint16)color);
-				ptr += pitch / 2;
-			}
-		} else {
-			uint32 *ptr = (uint32 *)getBasePtr(r.left, r.top);
-			while (height--) {
-				Common::set_to(ptr, ptr + width, color);
-				ptr += pitch / 4;
-			}
-		}
-	}
+	fillBlit((byte *)getBasePtr(r.left, r.top), pitch, r.width(), r.height(), format.bytesPerPixel, color);
 }
 
 void Surface::frameRect(const Common::Rect &r, uint32 color) {
@@ -201,7 +162,7 @@ void Surface::move(int dx, int dy, int height) {
 		error("Surface::move: bytesPerPixel must be 1, 2, or 4");
 
 	byte *src, *dst;
-	int x, y;
+	int y;
 
 	// vertical movement
 	if (dy > 0) {
@@ -224,48 +185,17 @@ void Surface::move(int dx, int dy, int height) {
 		}
 	}
 
-	// horizontal movement
-	if (dx > 0) {
-		// move right - copy from right to left
-		dst = (byte *)pixels + (pitch - format.bytesPerPixel);
-		src = dst - (dx * format.bytesPerPixel);
-		for (y = 0; y < height; y++) {
-			for (x = dx; x < w; x++) {
-				if (format.bytesPerPixel == 1) {
-					*dst-- = *src--;
-				} else if (format.bytesPerPixel == 2) {
-					*(uint16 *)dst = *(const uint16 *)src;
-					src -= 2;
-					dst -= 2;
-				} else if (format.bytesPerPixel == 4) {
-					*(uint32 *)dst = *(const uint32 *)src;
-					src -= 4;
-					dst -= 4;
-				}
-			}
-			src += pitch + (pitch - dx * format.bytesPerPixel);
-			dst += pitch + (pitch - dx * format.bytesPerPixel);
-		}
-	} else if (dx < 0)  {
-		// move left - copy from left to right
-		dst = (byte *)pixels;
-		src = dst - (dx * format.bytesPerPixel);
-		for (y = 0; y < height; y++) {
-			for (x = -dx; x < w; x++) {
-				if (format.bytesPerPixel == 1) {
-					*dst++ = *src++;
-				} else if (format.bytesPerPixel == 2) {
-					*(uint16 *)dst = *(const uint16 *)src;
-					src += 2;
-					dst += 2;
-				} else if (format.bytesPerPixel == 4) {
-					*(uint32 *)dst = *(const uint32 *)src;
-					src += 4;
-					dst += 4;
-				}
-			}
-			src += pitch - (pitch + dx * format.bytesPerPixel);
-			dst += pitch - (pitch + dx * format.bytesPerPixel);
+	// horizontal movement, row by row; the rows overlap with themselves
+	if (dx != 0 && ABS(dx) < w) {
+		const int shift = ABS(dx) * format.bytesPerPixel;
+		const int rowSize = w * format.bytesPerPixel - shift;
+
+		byte *row = (byte *)pixels;
+		for (y = 0; y < height; y++, row += pitch) {
+			if (dx > 0)
+				memmove(row + shift, row, rowSize);
+			else
+				memmove(row, row + shift, rowSize);
 		}
 	}
 }
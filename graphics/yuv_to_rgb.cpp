@@ -198,10 +198,18 @@ namespace Graphics {
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
 
-template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfHeight = yHeight >> 1;
-	int halfWidth = yWidth >> 1;
+/**
+ * Convert a YUV image with one chroma sample per block of
+ * (1 << hShift) x (1 << vShift) luma samples. The chroma part of the
+ * lookup is done once per block, and the block loops are unrolled by the
+ * compiler as their size is known at compile time.
+ */
+template<typename PixelInt, int hShift, int vShift>
+void convertYUVToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	const int blockWidth  = 1 << hShift;
+	const int blockHeight = 1 << vShift;
+	const int uvWidth  = yWidth  >> hShift;
+	const int uvHeight = yHeight >> vShift;
 
 	// Keep the tables in pointers here to avoid a dereference on each pixel
 	const int16 *Cr_r_tab = lookup->_colorTab;
@@ -210,48 +218,67 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
 	const uint32 *rgbToPix = lookup->_rgbToPix;
 
-	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+	for (int h = 0; h < uvHeight; h++) {
+		byte *dstBlock = dstPtr;
+		const byte *yBlock = ySrc;
+
+		for (int w = 0; w < uvWidth; w++) {
 			register const uint32 *L;
 
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
+			int16 cr_r  = Cr_r_tab[vSrc[w]];
+			int16 crb_g = Cr_g_tab[vSrc[w]] + Cb_g_tab[uSrc[w]];
+			int16 cb_b  = Cb_b_tab[uSrc[w]];
+
+			for (int y = 0; y < blockHeight; y++) {
+				const byte *yRow = yBlock + y * yPitch;
+				byte *dstRow = dstBlock + y * dstPitch;
+
+				for (int x = 0; x < blockWidth; x++) {
+					PUT_PIXEL(yRow[x], dstRow + x * sizeof(PixelInt));
+				}
+			}
+
+			yBlock += blockWidth;
+			dstBlock += blockWidth * sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
-		ySrc += (yPitch << 1) - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
+		dstPtr += dstPitch << vShift;
+		ySrc += yPitch << vShift;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
 	}
 }
 
-void convertYUV420ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+#undef PUT_PIXEL
+
+template<int hShift, int vShift>
+void convertYUVToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->pixels);
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 1) == 0);
-	assert((yHeight & 1) == 0);
+	assert((yWidth  & ((1 << hShift) - 1)) == 0);
+	assert((yHeight & ((1 << vShift) - 1)) == 0);
 
 	const YUVToRGBLookup *lookup = YUVToRGBMan.getLookup(dst->format);
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVToRGB<uint16, hShift, vShift>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV420ToRGB<uint32>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVToRGB<uint32, hShift, vShift>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+}
+
+void convertYUV420ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	convertYUVToRGB<1, 1>(dst, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+}
+
+void convertYUV422ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	convertYUVToRGB<1, 0>(dst, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+}
+
+void convertYUV410ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	convertYUVToRGB<2, 2>(dst, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 } // End of namespace Graphics
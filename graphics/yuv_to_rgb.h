@@ -40,6 +40,10 @@ struct Surface;
 /**
  * Convert a YUV420 image to an RGB surface
  *
+ * The destination may be bigger than the image, so it can also be the
+ * screen surface returned by OSystem::lockScreen(), avoiding an extra copy
+ * if the image is to be shown in the top left corner in the screen format.
+ *
  * @param dst     the destination surface
  * @param ySrc    the source of the y component
  * @param uSrc    the source of the u component
@@ -51,6 +55,21 @@ struct Surface;
  */
 void convertYUV420ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+/**
+ * Convert a YUV422 image, with half horizontal chroma resolution, to an RGB
+ * surface. The parameters are the same as for convertYUV420ToRGB(), except
+ * that yHeight may be odd.
+ */
+void convertYUV422ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
+/**
+ * Convert a YUV410 image, with a quarter of the horizontal and vertical
+ * chroma resolution, to an RGB surface. The parameters are the same as for
+ * convertYUV420ToRGB(), except that yWidth and yHeight must be divisible
+ * by 4.
+ */
+void convertYUV410ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
 } // End of namespace Graphics
 
 #endif
@@ -24,6 +24,9 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/serializer.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -48,6 +51,7 @@ const char * const ThemeEngine::kImageSearch = "search.bmp";
 
 struct TextDrawData {
 	const Graphics::Font *_fontPtr;
+	Common::String _fontFile;
 };
 
 struct TextColorData {
@@ -558,6 +562,7 @@ bool ThemeEngine::addFont(TextData textId, const Common::String &file) {
 		delete _texts[textId];
 
 	_texts[textId] = new TextDrawData;
+	_texts[textId]->_fontFile = file;
 
 	if (file == "default") {
 		_texts[textId]->_fontPtr = _font;
@@ -616,6 +621,8 @@ bool ThemeEngine::addTextColor(TextColor colorId, int r, int g, int b) {
 }
 
 bool ThemeEngine::addBitmap(const Common::String &filename) {
+	_themeBitmaps.push_back(filename);
+
 	// Nothing has to be done if the bitmap already has been loaded.
 	Graphics::Surface *surf = _bitmaps[filename];
 	if (surf)
@@ -662,9 +669,14 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 
 	if (themeId == "builtin") {
 		_themeOk = loadDefaultXML();
+	} else if (loadThemeCache()) {
+		_themeOk = true;
 	} else {
 		// Load the archive containing image and XML data
 		_themeOk = loadThemeXML(themeId);
+
+		if (_themeOk)
+			saveThemeCache();
 	}
 
 	if (!_themeOk) {
@@ -682,9 +694,6 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 }
 
 void ThemeEngine::unloadTheme() {
-	if (!_themeOk)
-		return;
-
 	for (int i = 0; i < kDrawDataMAX; ++i) {
 		delete _widgets[i];
 		_widgets[i] = 0;
@@ -700,6 +709,9 @@ void ThemeEngine::unloadTheme() {
 		_textColors[i] = 0;
 	}
 
+	_themeBitmaps.clear();
+	_cursorFile.clear();
+
 	_themeEval->reset();
 	_themeOk = false;
 }
@@ -787,6 +799,326 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 }
 
 
+/**********************************************************
+ * Binary theme cache
+ *********************************************************/
+
+// Increase this whenever the cache format or the way themes are parsed changes
+enum {
+	THEME_CACHE_VERSION = 1
+};
+
+// The drawing functions a DrawStep can use, indexed by their number in the cache
+static const Graphics::DrawingFunctionCallback kCacheDrawingFunctions[] = {
+	&Graphics::VectorRenderer::drawCallback_CIRCLE,
+	&Graphics::VectorRenderer::drawCallback_SQUARE,
+	&Graphics::VectorRenderer::drawCallback_ROUNDSQ,
+	&Graphics::VectorRenderer::drawCallback_BEVELSQ,
+	&Graphics::VectorRenderer::drawCallback_LINE,
+	&Graphics::VectorRenderer::drawCallback_TRIANGLE,
+	&Graphics::VectorRenderer::drawCallback_FILLSURFACE,
+	&Graphics::VectorRenderer::drawCallback_TAB,
+	&Graphics::VectorRenderer::drawCallback_VOID,
+	&Graphics::VectorRenderer::drawCallback_BITMAP,
+	&Graphics::VectorRenderer::drawCallback_CROSS
+};
+
+static void syncDrawStepColor(Common::Serializer &s, Graphics::DrawStep::Color &color) {
+	s.syncAsByte(color.r);
+	s.syncAsByte(color.g);
+	s.syncAsByte(color.b);
+	s.syncAsByte(color.set);
+}
+
+Common::String ThemeEngine::genThemeCacheFilename() const {
+	return Common::String::format("%s-%dx%d.stc", _themeId.c_str(),
+	                              _system->getOverlayWidth(), _system->getOverlayHeight());
+}
+
+Common::String ThemeEngine::computeThemeHash() const {
+	Common::FSNode node(_themeFile);
+	Common::String hash;
+
+	if (node.isDirectory()) {
+		// Use the files which are parsed for the theme
+		Common::ArchiveMemberList members;
+		_themeArchive->listMatchingMembers(members, "*.stx");
+		_themeArchive->listMatchingMembers(members, "THEMERC");
+
+		for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
+			Common::SeekableReadStream *stream = (*i)->createReadStream();
+			if (!stream)
+				return Common::String();
+
+			hash += (*i)->getName() + ":" + Common::computeStreamMD5AsString(*stream) + " ";
+			delete stream;
+		}
+	} else {
+		// Zip files are hashed as a whole, which is much faster than
+		// decompressing them
+		Common::SeekableReadStream *stream = 0;
+
+		Common::ArchiveMemberPtr member = SearchMan.getMember(_themeFile);
+		if (member)
+			stream = member->createReadStream();
+		else
+			stream = node.createReadStream();
+
+		if (!stream)
+			return Common::String();
+
+		hash = Common::computeStreamMD5AsString(*stream);
+		delete stream;
+	}
+
+	return hash;
+}
+
+bool ThemeEngine::loadThemeCache() {
+	if (!_themeArchive)
+		return false;
+
+	Common::File cacheFile;
+	if (!cacheFile.open(genThemeCacheFilename()))
+		return false;
+
+	// The cache is read in many small pieces, so load it into memory first
+	Common::SeekableReadStream *stream = cacheFile.readStream(cacheFile.size());
+	cacheFile.close();
+
+	if (!stream)
+		return false;
+
+	// Reject truncated files right away
+	stream->seek(-4, SEEK_END);
+	if (stream->readUint32BE() != MKTAG('S', 'T', 'C', 'E')) {
+		delete stream;
+		return false;
+	}
+	stream->seek(0);
+
+	Common::Serializer s(stream, 0);
+
+	uint32 version = 0;
+	Common::String themeVersion, hash;
+	uint16 width = 0, height = 0;
+
+	bool valid = s.matchBytes("STCF", 4);
+	s.syncAsUint32BE(version);
+	s.syncString(themeVersion);
+	s.syncString(hash);
+	s.syncAsUint16BE(width);
+	s.syncAsUint16BE(height);
+
+	valid = valid && (version == THEME_CACHE_VERSION) && (themeVersion == SCUMMVM_THEME_VERSION_STR) &&
+	        (width == _system->getOverlayWidth()) && (height == _system->getOverlayHeight()) &&
+	        (hash == computeThemeHash());
+
+	if (valid && !syncThemeCache(s)) {
+		warning("Invalid cache file for theme '%s'", _themeId.c_str());
+
+		// Get rid of whatever was loaded before the error
+		unloadTheme();
+		valid = false;
+	}
+
+	delete stream;
+	return valid;
+}
+
+void ThemeEngine::saveThemeCache() {
+	Common::String hash = computeThemeHash();
+	if (hash.empty())
+		return;
+
+	Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+	Common::Serializer s(0, &stream);
+
+	uint32 version = THEME_CACHE_VERSION;
+	Common::String themeVersion = SCUMMVM_THEME_VERSION_STR;
+	uint16 width = _system->getOverlayWidth();
+	uint16 height = _system->getOverlayHeight();
+
+	s.matchBytes("STCF", 4);
+	s.syncAsUint32BE(version);
+	s.syncString(themeVersion);
+	s.syncString(hash);
+	s.syncAsUint16BE(width);
+	s.syncAsUint16BE(height);
+
+	if (!syncThemeCache(s))
+		return;
+
+	s.matchBytes("STCE", 4);
+
+	// Only create the file once all data is there, so that no incomplete
+	// cache files are left behind
+	Common::DumpFile cacheFile;
+	if (!cacheFile.open(genThemeCacheFilename()) ||
+	    cacheFile.write(stream.getData(), stream.size()) != stream.size() || cacheFile.err())
+		warning("Couldn't create cache file for theme '%s'", _themeId.c_str());
+}
+
+bool ThemeEngine::syncThemeCache(Common::Serializer &s) {
+	s.syncString(_themeName);
+
+	// The bitmaps must be loaded first, as the draw steps and the cursor
+	// refer to them
+	uint16 count = _themeBitmaps.size();
+	s.syncAsUint16BE(count);
+
+	if (s.isSaving()) {
+		for (uint i = 0; i < count; ++i)
+			s.syncString(_themeBitmaps[i]);
+	} else {
+		for (uint i = 0; i < count; ++i) {
+			Common::String filename;
+			s.syncString(filename);
+
+			if (!addBitmap(filename))
+				return false;
+		}
+	}
+
+	for (int i = 0; i < kTextDataMAX; ++i) {
+		bool present = (_texts[i] != 0);
+		s.syncAsByte(present);
+
+		if (!present)
+			continue;
+
+		Common::String file;
+		if (s.isSaving())
+			file = _texts[i]->_fontFile;
+
+		s.syncString(file);
+
+		if (s.isLoading() && !addFont((TextData)i, file))
+			return false;
+	}
+
+	for (int i = 0; i < kTextColorMAX; ++i) {
+		bool present = (_textColors[i] != 0);
+		s.syncAsByte(present);
+
+		if (!present)
+			continue;
+
+		if (s.isLoading())
+			_textColors[i] = new TextColorData;
+
+		s.syncAsByte(_textColors[i]->r);
+		s.syncAsByte(_textColors[i]->g);
+		s.syncAsByte(_textColors[i]->b);
+	}
+
+	for (int i = 0; i < kDrawDataMAX; ++i) {
+		bool present = (_widgets[i] != 0);
+		s.syncAsByte(present);
+
+		if (!present)
+			continue;
+
+		if (s.isLoading())
+			_widgets[i] = new WidgetDrawData;
+
+		WidgetDrawData *widget = _widgets[i];
+
+		s.syncAsSint16BE(widget->_textDataId);
+		s.syncAsSint16BE(widget->_textColorId);
+		s.syncAsSint16BE(widget->_textAlignH);
+		s.syncAsSint16BE(widget->_textAlignV);
+		s.syncAsByte(widget->_buffer);
+
+		count = widget->_steps.size();
+		s.syncAsUint16BE(count);
+
+		Common::List<Graphics::DrawStep>::iterator step = widget->_steps.begin();
+		for (uint j = 0; j < count; ++j) {
+			if (s.isLoading()) {
+				widget->_steps.push_back(Graphics::DrawStep());
+				step = widget->_steps.reverse_begin();
+			}
+
+			syncDrawStepColor(s, step->fgColor);
+			syncDrawStepColor(s, step->bgColor);
+			syncDrawStepColor(s, step->gradColor1);
+			syncDrawStepColor(s, step->gradColor2);
+			syncDrawStepColor(s, step->bevelColor);
+
+			s.syncAsByte(step->autoWidth);
+			s.syncAsByte(step->autoHeight);
+			s.syncAsSint16BE(step->x);
+			s.syncAsSint16BE(step->y);
+			s.syncAsSint16BE(step->w);
+			s.syncAsSint16BE(step->h);
+			s.syncAsByte(step->xAlign);
+			s.syncAsByte(step->yAlign);
+			s.syncAsByte(step->shadow);
+			s.syncAsByte(step->stroke);
+			s.syncAsByte(step->factor);
+			s.syncAsByte(step->radius);
+			s.syncAsByte(step->bevel);
+			s.syncAsByte(step->fillMode);
+			s.syncAsUint32BE(step->extraData);
+			s.syncAsUint32BE(step->scale);
+
+			byte function = 0;
+			Common::String bitmap;
+
+			if (s.isSaving()) {
+				while (function < ARRAYSIZE(kCacheDrawingFunctions) && kCacheDrawingFunctions[function] != step->drawingCall)
+					function++;
+
+				if (function == ARRAYSIZE(kCacheDrawingFunctions))
+					return false;
+
+				if (step->blitSrc) {
+					for (ImagesMap::const_iterator k = _bitmaps.begin(); k != _bitmaps.end(); ++k) {
+						if (k->_value == step->blitSrc) {
+							bitmap = k->_key;
+							break;
+						}
+					}
+
+					if (bitmap.empty())
+						return false;
+				}
+			}
+
+			s.syncAsByte(function);
+			s.syncString(bitmap);
+
+			if (s.isLoading()) {
+				if (function >= ARRAYSIZE(kCacheDrawingFunctions))
+					return false;
+
+				step->drawingCall = kCacheDrawingFunctions[function];
+				step->blitSrc = bitmap.empty() ? 0 : getBitmap(bitmap);
+
+				if (!bitmap.empty() && !step->blitSrc)
+					return false;
+			} else {
+				++step;
+			}
+		}
+	}
+
+	Common::String cursorFile = _cursorFile;
+	int hotspotX = _cursorHotspotX, hotspotY = _cursorHotspotY, scale = _cursorTargetScale;
+
+	s.syncString(cursorFile);
+	s.syncAsSint16BE(hotspotX);
+	s.syncAsSint16BE(hotspotY);
+	s.syncAsSint16BE(scale);
+
+	if (s.isLoading() && !cursorFile.empty() && !createCursor(cursorFile, hotspotX, hotspotY, scale))
+		return false;
+
+	return _themeEval->syncCache(s);
+}
+
+
 
 /**********************************************************
  * Drawing Queue management
@@ -1272,6 +1604,8 @@ void ThemeEngine::openDialog(bool doBuffer, ShadingStyle style) {
 }
 
 bool ThemeEngine::createCursor(const Common::String &filename, int hotspotX, int hotspotY, int scale) {
+	_cursorFile = filename;
+
 	if (!_system->hasFeature(OSystem::kFeatureCursorPalette))
 		return true;
 
@@ -29,6 +29,7 @@
 #include "common/hashmap.h"
 #include "common/list.h"
 #include "common/str.h"
+#include "common/str-array.h"
 
 #include "graphics/surface.h"
 #include "graphics/font.h"
@@ -41,6 +42,7 @@ class OSystem;
 
 namespace Common {
 struct Rect;
+class Serializer;
 }
 
 namespace Graphics {
@@ -529,6 +531,24 @@ protected:
 	 */
 	bool loadDefaultXML();
 
+	/**
+	 * Loads the theme from the binary theme cache, if there is a cache file
+	 * for the current overlay resolution which matches the theme files.
+	 *
+	 * @returns true if the theme was successfully loaded from the cache.
+	 */
+	bool loadThemeCache();
+
+	/**
+	 * Writes the loaded theme to the binary theme cache, so that its XML
+	 * files don't have to be parsed the next time it is loaded.
+	 */
+	void saveThemeCache();
+
+	bool syncThemeCache(Common::Serializer &s);
+	Common::String genThemeCacheFilename() const;
+	Common::String computeThemeHash() const;
+
 	/**
 	 * Unloads the currently loaded theme so another one can
 	 * be loaded.
@@ -636,6 +656,9 @@ protected:
 
 	ImagesMap _bitmaps;
 	Graphics::PixelFormat _overlayFormat;
+
+	/** Bitmaps used by the loaded theme, in the order the theme loaded them. */
+	Common::StringArray _themeBitmaps;
 #ifdef USE_RGB_COLOR
 	Graphics::PixelFormat _cursorFormat;
 #endif
@@ -659,6 +682,7 @@ protected:
 	Common::Archive *_themeArchive;
 
 	bool _useCursor;
+	Common::String _cursorFile;
 	int _cursorHotspotX, _cursorHotspotY;
 	int _cursorTargetScale;
 	enum {
@@ -24,6 +24,9 @@
 
 #include "graphics/scaler.h"
 
+#include "common/algorithm.h"
+#include "common/serializer.h"
+#include "common/str-array.h"
 #include "common/system.h"
 #include "common/tokenizer.h"
 
@@ -50,6 +53,70 @@ void ThemeEval::reset() {
 	_layouts.clear();
 }
 
+bool ThemeEval::syncCache(Common::Serializer &s) {
+	assert(_curLayout.empty());
+
+	// Variables and layouts are saved sorted by name, so that the cache
+	// doesn't depend on the hash map order
+	Common::StringArray names;
+
+	if (s.isSaving()) {
+		for (VariablesMap::iterator i = _vars.begin(); i != _vars.end(); ++i)
+			names.push_back(i->_key);
+		Common::sort(names.begin(), names.end());
+	}
+
+	uint32 count = names.size();
+	s.syncAsUint32BE(count);
+
+	for (uint32 i = 0; i < count; ++i) {
+		Common::String name;
+		int32 value = 0;
+
+		if (s.isSaving()) {
+			name = names[i];
+			value = _vars[name];
+		}
+
+		s.syncString(name);
+		s.syncAsSint32BE(value);
+
+		if (s.isLoading())
+			_vars[name] = value;
+	}
+
+	names.clear();
+
+	if (s.isSaving()) {
+		for (LayoutsMap::iterator i = _layouts.begin(); i != _layouts.end(); ++i)
+			names.push_back(i->_key);
+		Common::sort(names.begin(), names.end());
+	}
+
+	count = names.size();
+	s.syncAsUint32BE(count);
+
+	for (uint32 i = 0; i < count; ++i) {
+		Common::String name;
+
+		if (s.isSaving()) {
+			name = names[i];
+			s.syncString(name);
+			_layouts[name]->saveToCache(s);
+		} else {
+			s.syncString(name);
+			ThemeLayout *layout = ThemeLayout::loadFromCache(s, 0);
+			if (!layout)
+				return false;
+
+			delete _layouts[name];
+			_layouts[name] = layout;
+		}
+	}
+
+	return true;
+}
+
 bool ThemeEval::getWidgetData(const Common::String &widget, int16 &x, int16 &y, uint16 &w, uint16 &h) {
 	Common::StringTokenizer tokenizer(widget, ".");
 
@@ -97,6 +97,14 @@ public:
 
 	void reset();
 
+	/**
+	 * Save the variables and layouts to the theme cache, or load them
+	 * from it after a reset().
+	 *
+	 * @return false if the cached data is invalid
+	 */
+	bool syncCache(Common::Serializer &s);
+
 private:
 	VariablesMap _vars;
 	VariablesMap _builtin;
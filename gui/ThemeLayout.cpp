@@ -21,6 +21,7 @@
  */
 
 #include "common/util.h"
+#include "common/serializer.h"
 #include "common/system.h"
 
 #include "gui/ThemeLayout.h"
@@ -121,6 +122,98 @@ int16 ThemeLayoutStacked::getParentHeight() {
 	return p->getHeight() - height;
 }
 
+void ThemeLayout::saveToCache(Common::Serializer &s) {
+	byte type = getCacheType();
+	s.syncAsByte(type);
+
+	syncCache(s);
+}
+
+ThemeLayout *ThemeLayout::loadFromCache(Common::Serializer &s, ThemeLayout *parent) {
+	byte type = 0;
+	s.syncAsByte(type);
+
+	// Only the root of a layout tree is a main layout
+	if ((type == kCacheMain) != (parent == 0))
+		return 0;
+
+	ThemeLayout *layout = 0;
+
+	switch (type) {
+	case kCacheMain:
+		layout = new ThemeLayoutMain(-1, -1, -1, -1);
+		break;
+	case kCacheVertical:
+		layout = new ThemeLayoutStacked(parent, kLayoutVertical, 0, false);
+		break;
+	case kCacheHorizontal:
+		layout = new ThemeLayoutStacked(parent, kLayoutHorizontal, 0, false);
+		break;
+	case kCacheWidget:
+		layout = new ThemeLayoutWidget(parent, Common::String(), -1, -1, Graphics::kTextAlignInvalid);
+		break;
+	case kCacheSpacing:
+		layout = new ThemeLayoutSpacing(parent, 0);
+		break;
+	default:
+		return 0;
+	}
+
+	if (!layout->syncCache(s)) {
+		delete layout;
+		return 0;
+	}
+
+	return layout;
+}
+
+bool ThemeLayout::syncCache(Common::Serializer &s) {
+	s.syncAsSint16BE(_x);
+	s.syncAsSint16BE(_y);
+	s.syncAsSint16BE(_w);
+	s.syncAsSint16BE(_h);
+	s.syncAsSint16BE(_padding.left);
+	s.syncAsSint16BE(_padding.right);
+	s.syncAsSint16BE(_padding.top);
+	s.syncAsSint16BE(_padding.bottom);
+	s.syncAsByte(_centered);
+	s.syncAsSint16BE(_defaultW);
+	s.syncAsSint16BE(_defaultH);
+	s.syncAsSint16BE(_textHAlign);
+
+	syncCacheData(s);
+
+	uint16 count = _children.size();
+	s.syncAsUint16BE(count);
+
+	for (uint i = 0; i < count; ++i) {
+		if (s.isSaving()) {
+			_children[i]->saveToCache(s);
+		} else {
+			ThemeLayout *child = loadFromCache(s, this);
+			if (!child)
+				return false;
+
+			_children.push_back(child);
+		}
+	}
+
+	return true;
+}
+
+void ThemeLayoutMain::syncCacheData(Common::Serializer &s) {
+	s.syncAsSint16BE(_defaultX);
+	s.syncAsSint16BE(_defaultY);
+}
+
+void ThemeLayoutStacked::syncCacheData(Common::Serializer &s) {
+	s.syncAsByte(_spacing);
+}
+
+void ThemeLayoutWidget::syncCacheData(Common::Serializer &s) {
+	s.syncString(_name);
+}
+
 #ifdef LAYOUT_DEBUG_DIALOG
 void ThemeLayout::debugDraw(Graphics::Surface *screen, const Graphics::Font *font) {
 	uint16 color = 0xFFFF;
@@ -27,6 +27,10 @@
 #include "common/rect.h"
 #include "graphics/font.h"
 
+namespace Common {
+class Serializer;
+}
+
 #ifdef LAYOUT_DEBUG_DIALOG
 namespace Graphics {
 class Surface;
@@ -104,6 +108,19 @@ public:
 
 	Graphics::TextAlign getTextHAlign() { return _textHAlign; }
 
+	/**
+	 * Write the layout and all its children to the theme cache.
+	 */
+	void saveToCache(Common::Serializer &s);
+
+	/**
+	 * Create a layout with all its children from the data written by
+	 * saveToCache().
+	 *
+	 * @return the new layout, or 0 if the data is invalid
+	 */
+	static ThemeLayout *loadFromCache(Common::Serializer &s, ThemeLayout *parent);
+
 #ifdef LAYOUT_DEBUG_DIALOG
 	void debugDraw(Graphics::Surface *screen, const Graphics::Font *font);
 
@@ -111,6 +128,21 @@ public:
 #endif
 
 protected:
+	enum CacheType {
+		kCacheMain,
+		kCacheVertical,
+		kCacheHorizontal,
+		kCacheWidget,
+		kCacheSpacing
+	};
+
+	virtual CacheType getCacheType() const = 0;
+
+	/** Sync the layout data which is specific to each kind of layout. */
+	virtual void syncCacheData(Common::Serializer &s) {}
+
+	bool syncCache(Common::Serializer &s);
+
 	ThemeLayout *_parent;
 	int16 _x, _y, _w, _h;
 	Common::Rect _padding;
@@ -144,6 +176,9 @@ protected:
 	LayoutType getLayoutType() { return kLayoutMain; }
 	ThemeLayout *makeClone(ThemeLayout *newParent) { assert(!"Do not copy Main Layouts!"); return 0; }
 
+	CacheType getCacheType() const { return kCacheMain; }
+	void syncCacheData(Common::Serializer &s);
+
 	int16 _defaultX;
 	int16 _defaultY;
 };
@@ -179,6 +214,9 @@ protected:
 
 	LayoutType getLayoutType() { return _type; }
 
+	CacheType getCacheType() const { return (_type == kLayoutVertical) ? kCacheVertical : kCacheHorizontal; }
+	void syncCacheData(Common::Serializer &s);
+
 	ThemeLayout *makeClone(ThemeLayout *newParent) {
 		ThemeLayoutStacked *n = new ThemeLayoutStacked(*this);
 		n->_parent = newParent;
@@ -214,6 +252,9 @@ public:
 protected:
 	LayoutType getLayoutType() { return kLayoutWidget; }
 
+	CacheType getCacheType() const { return kCacheWidget; }
+	void syncCacheData(Common::Serializer &s);
+
 	ThemeLayout *makeClone(ThemeLayout *newParent) {
 		ThemeLayout *n = new ThemeLayoutWidget(*this);
 		n->_parent = newParent;
@@ -244,6 +285,8 @@ public:
 protected:
 	LayoutType getLayoutType() { return kLayoutWidget; }
 
+	CacheType getCacheType() const { return kCacheSpacing; }
+
 	ThemeLayout *makeClone(ThemeLayout *newParent) {
 		ThemeLayout *n = new ThemeLayoutSpacing(*this);
 		n->_parent = newParent;
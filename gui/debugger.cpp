@@ -24,10 +24,18 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #include "engines/engine.h"
 
+#include "audio/mixer.h"
+
+#include "graphics/font.h"
+#include "graphics/fontman.h"
+#include "graphics/surface.h"
+
 #include "gui/debugger.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	#include "gui/console.h"
@@ -64,6 +72,11 @@ Debugger::Debugger() {
 	DCmd_Register("debugflag_list",		WRAP_METHOD(Debugger, Cmd_DebugFlagsList));
 	DCmd_Register("debugflag_enable",	WRAP_METHOD(Debugger, Cmd_DebugFlagEnable));
 	DCmd_Register("debugflag_disable",	WRAP_METHOD(Debugger, Cmd_DebugFlagDisable));
+
+	DCmd_Register("mixer",				WRAP_METHOD(Debugger, Cmd_Mixer));
+	DCmd_Register("perf",				WRAP_METHOD(Debugger, Cmd_Perf));
+	DCmd_Register("fontbench",			WRAP_METHOD(Debugger, Cmd_FontBenchmark));
+	DCmd_Register("timers",				WRAP_METHOD(Debugger, Cmd_Timers));
 }
 
 Debugger::~Debugger() {
@@ -529,6 +542,113 @@ bool Debugger::Cmd_DebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::Cmd_Mixer(int argc, const char **argv) {
+	Audio::Mixer *mixer = g_system->getMixer();
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		mixer->resetStats();
+		DebugPrintf("Reset the mixer statistics\n");
+	} else if (argc == 1) {
+		const Common::Array<Common::String> lines = mixer->formatStats();
+		if (lines.empty())
+			DebugPrintf("The mixer of this backend keeps no statistics\n");
+		for (uint i = 0; i < lines.size(); ++i)
+			DebugPrintf("%s\n", lines[i].c_str());
+	} else {
+		DebugPrintf("Usage: %s [reset]\n", argv[0]);
+	}
+	return true;
+}
+
+bool Debugger::Cmd_Perf(int argc, const char **argv) {
+#ifdef ENABLE_PERF_COUNTERS
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		ProfileMan.resetCounters();
+		DebugPrintf("Reset all profiling counters\n");
+	} else if (argc == 3 && !strcmp(argv[1], "dump")) {
+		if (ProfileMan.dumpCounters(argv[2]))
+			DebugPrintf("Dumped profiling counters to '%s'\n", argv[2]);
+		else
+			DebugPrintf("Failed to dump profiling counters to '%s'\n", argv[2]);
+	} else if (argc == 1) {
+		const Common::Array<Common::String> lines = ProfileMan.formatCounters();
+		for (uint i = 0; i < lines.size(); ++i)
+			DebugPrintf("%s\n", lines[i].c_str());
+	} else {
+		DebugPrintf("Usage: %s [reset | dump <file>]\n", argv[0]);
+	}
+#else
+	DebugPrintf("Profiling support was not compiled in (configure with --enable-perf-counters)\n");
+#endif
+	return true;
+}
+
+bool Debugger::Cmd_Timers(int argc, const char **argv) {
+	Common::TimerManager *timerManager = g_system->getTimerManager();
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		timerManager->resetStats();
+		DebugPrintf("Reset the timer statistics\n");
+	} else if (argc == 1) {
+		const Common::Array<Common::String> lines = timerManager->formatStats();
+		if (lines.empty())
+			DebugPrintf("The timer manager of this backend keeps no statistics\n");
+		for (uint i = 0; i < lines.size(); ++i)
+			DebugPrintf("%s\n", lines[i].c_str());
+	} else {
+		DebugPrintf("Usage: %s [reset]\n", argv[0]);
+	}
+	return true;
+}
+
+bool Debugger::Cmd_FontBenchmark(int argc, const char **argv) {
+	if (argc > 2) {
+		DebugPrintf("Usage: %s [iterations]\n", argv[0]);
+		return true;
+	}
+
+	const int iterations = (argc == 2) ? MAX(1, atoi(argv[1])) : 100;
+	const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kGUIFont);
+
+	const Common::String text =
+		"The quick brown fox jumps over the lazy dog. ScummVM is a program which "
+		"allows you to run certain classic graphical point-and-click adventure "
+		"games, provided you already have their data files. The clever part about "
+		"this: ScummVM just replaces the executables shipped with the games, "
+		"allowing you to play them on systems for which they were never designed!";
+
+	Graphics::Surface surface;
+	surface.create(320, 200, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+
+	Common::Array<Common::String> lines;
+
+	// The first wrap fills the layout cache, all further ones are served from it
+	uint32 start = ProfileMan.getMicros();
+	font->wordWrapText(text, surface.w, lines);
+	const uint32 firstWrapMicros = ProfileMan.getMicros() - start;
+
+	start = ProfileMan.getMicros();
+	for (int i = 0; i < iterations; ++i) {
+		lines.clear();
+		font->wordWrapText(text, surface.w, lines);
+	}
+	const uint32 wrapMicros = ProfileMan.getMicros() - start;
+
+	start = ProfileMan.getMicros();
+	for (int i = 0; i < iterations; ++i) {
+		for (uint j = 0; j < lines.size(); ++j)
+			font->drawString(&surface, lines[j], 0, j * font->getFontHeight(), surface.w, 0xFFFF);
+	}
+	const uint32 drawMicros = ProfileMan.getMicros() - start;
+
+	surface.free();
+
+	DebugPrintf("Wrapped %u characters into %u lines: first %u us, then %u us on average\n",
+		text.size(), lines.size(), firstWrapMicros, wrapMicros / iterations);
+	DebugPrintf("Drew %u lines: %u us on average\n", lines.size(), drawMicros / iterations);
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
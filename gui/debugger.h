@@ -195,6 +195,10 @@ protected:
 	bool Cmd_DebugFlagsList(int argc, const char **argv);
 	bool Cmd_DebugFlagEnable(int argc, const char **argv);
 	bool Cmd_DebugFlagDisable(int argc, const char **argv);
+	bool Cmd_Mixer(int argc, const char **argv);
+	bool Cmd_Perf(int argc, const char **argv);
+	bool Cmd_FontBenchmark(int argc, const char **argv);
+	bool Cmd_Timers(int argc, const char **argv);
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
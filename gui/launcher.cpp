@@ -21,6 +21,7 @@
 
 #include "base/version.h"
 
+#include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/events.h"
 #include "common/fs.h"
@@ -657,11 +658,26 @@ void LauncherDialog::close() {
 	Dialog::close();
 }
 
+namespace {
+
+struct LauncherEntry {
+	Common::String key;
+	Common::String description;
+};
+
+struct LauncherEntryLess {
+	bool operator()(const LauncherEntry &x, const LauncherEntry &y) const {
+		const int cmp = scumm_stricmp(x.description.c_str(), y.description.c_str());
+		return cmp < 0 || (cmp == 0 && x.key < y.key);
+	}
+};
+
+} // End of anonymous namespace
+
 void LauncherDialog::updateListing() {
-	StringArray l;
+	Common::Array<LauncherEntry> entries;
 
 	// Retrieve a list of all games defined in the config file
-	_domains.clear();
 	const ConfigManager::DomainMap &domains = ConfMan.getGameDomains();
 	ConfigManager::DomainMap::const_iterator iter;
 	for (iter = domains.begin(); iter != domains.end(); ++iter) {
@@ -689,16 +705,29 @@ void LauncherDialog::updateListing() {
 		}
 
 		if (!gameid.empty() && !description.empty()) {
-			// Insert the game into the launcher list
-			int pos = 0, size = l.size();
-
-			while (pos < size && (scumm_stricmp(description.c_str(), l[pos].c_str()) > 0))
-				pos++;
-			l.insert_at(pos, description);
-			_domains.insert_at(pos, iter->_key);
+			LauncherEntry entry;
+			entry.key = iter->_key;
+			entry.description = description;
+			entries.push_back(entry);
 		}
 	}
 
+	// Sort the games by description, and by target for equal descriptions.
+	// Sorting once is much faster than inserting every game at its place
+	// when there are lots of games.
+	Common::sort(entries.begin(), entries.end(), LauncherEntryLess());
+
+	StringArray l;
+	l.reserve(entries.size());
+
+	_domains.clear();
+	_domains.reserve(entries.size());
+
+	for (Common::Array<LauncherEntry>::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+		l.push_back(i->description);
+		_domains.push_back(i->key);
+	}
+
 	const int oldSel = _list->getSelected();
 	_list->setList(l);
 	if (oldSel < (int)l.size())
@@ -19,7 +19,11 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include "common/algorithm.h"
 #include "common/config-manager.h"
+#include "common/hash-str.h"
+#include "common/savefile.h"
+#include "common/system.h"
 #include "common/translation.h"
 
 #include "gui/widgets/list.h"
@@ -155,6 +159,8 @@ void SaveLoadChooser::handleCommand(CommandSender *sender, uint32 cmd, uint32 da
 								_("Delete"), _("Cancel"));
 			if (alert.runModal() == GUI::kMessageOK) {
 				(*_plugin)->removeSaveState(_target.c_str(), _saveList[selItem].getSaveSlot());
+				if (g_system->getSavefileManager()->supportsSaveIndex())
+					g_system->getSavefileManager()->removeSavefile(Common::SaveFileManager::getSaveIndexName(_target));
 
 				setResult(-1);
 				_list->setSelected(-1);
@@ -320,8 +326,112 @@ void SaveLoadChooser::close() {
 	Dialog::close();
 }
 
+enum {
+	kSaveIndexVersion = 1
+};
+
+/**
+ * Computes a hash of the names of all savefiles except the save indexes.
+ * Savefiles which are added or removed without going through ScummVM
+ * change it, and thereby make the save indexes stale.
+ */
+static uint32 hashSavefileNames(Common::SaveFileManager *saveFileMan, uint32 &count) {
+	Common::StringArray files = saveFileMan->listSavefiles("*");
+	Common::sort(files.begin(), files.end());
+
+	uint32 hash = 0;
+	count = 0;
+
+	for (Common::StringArray::const_iterator i = files.begin(); i != files.end(); ++i) {
+		if (Common::SaveFileManager::isSaveIndexName(*i))
+			continue;
+
+		hash = hash * 31 + Common::hashit(i->c_str());
+		count++;
+	}
+
+	return hash;
+}
+
+static bool loadSaveIndex(Common::InSaveFile *in, uint32 fileCount, uint32 fileHash, SaveStateList &saveList) {
+	if (in->readUint32BE() != MKTAG('S', 'I', 'D', 'X') || in->readByte() != kSaveIndexVersion)
+		return false;
+
+	if (in->readUint32BE() != fileCount || in->readUint32BE() != fileHash)
+		return false;
+
+	const uint32 count = in->readUint32BE();
+
+	for (uint32 i = 0; i < count && !in->eos() && !in->err(); i++) {
+		const int slot = in->readSint32BE();
+		const uint16 length = in->readUint16BE();
+
+		Common::String description;
+		for (uint16 j = 0; j < length; j++)
+			description += (char)in->readByte();
+
+		saveList.push_back(SaveStateDescriptor(slot, description));
+	}
+
+	return !in->eos() && !in->err();
+}
+
+static bool writeSaveIndex(Common::OutSaveFile *out, uint32 fileCount, uint32 fileHash, const SaveStateList &saveList) {
+	out->writeUint32BE(MKTAG('S', 'I', 'D', 'X'));
+	out->writeByte(kSaveIndexVersion);
+	out->writeUint32BE(fileCount);
+	out->writeUint32BE(fileHash);
+	out->writeUint32BE(saveList.size());
+
+	for (SaveStateList::const_iterator x = saveList.begin(); x != saveList.end(); ++x) {
+		out->writeSint32BE(x->getSaveSlot());
+		out->writeUint16BE(x->getDescription().size());
+		out->writeString(x->getDescription());
+	}
+
+	out->finalize();
+	return !out->err();
+}
+
+SaveStateList SaveLoadChooser::listSaves() {
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!saveFileMan->supportsSaveIndex())
+		return (*_plugin)->listSaves(_target.c_str());
+
+	const String indexName = Common::SaveFileManager::getSaveIndexName(_target);
+
+	uint32 fileCount;
+	const uint32 fileHash = hashSavefileNames(saveFileMan, fileCount);
+
+	SaveStateList saveList;
+
+	Common::InSaveFile *in = saveFileMan->openForLoading(indexName);
+	if (in) {
+		const bool valid = loadSaveIndex(in, fileCount, fileHash, saveList);
+		delete in;
+
+		if (valid)
+			return saveList;
+
+		saveList.clear();
+	}
+
+	saveList = (*_plugin)->listSaves(_target.c_str());
+
+	Common::OutSaveFile *out = saveFileMan->openForSaving(indexName);
+	if (out) {
+		const bool written = writeSaveIndex(out, fileCount, fileHash, saveList);
+		delete out;
+
+		if (!written)
+			saveFileMan->removeSavefile(indexName);
+	}
+
+	return saveList;
+}
+
 void SaveLoadChooser::updateSaveList() {
-	_saveList = (*_plugin)->listSaves(_target.c_str());
+	_saveList = listSaves();
 
 	int curSlot = 0;
 	int saveSlot = 0;
@@ -61,6 +61,13 @@ protected:
 
 	void updateSaveList();
 	void updateSelection(bool redraw);
+
+	/**
+	 * Returns the save states of the target. They are read from the save
+	 * index of the target if it is up to date, otherwise they are listed by
+	 * the engine and the save index is rewritten.
+	 */
+	SaveStateList listSaves();
 public:
 	SaveLoadChooser(const String &title, const String &buttonLabel);
 	~SaveLoadChooser();
@@ -157,6 +157,11 @@ void ListWidget::setList(const StringArray &list, const ColorList *colors) {
 	_dataList = list;
 	_list = list;
 	_filter.clear();
+
+	_searchList = list;
+	for (StringArray::iterator i = _searchList.begin(); i != _searchList.end(); ++i)
+		i->toLowercase();
+
 	_listIndex.clear();
 	_listColors.clear();
 
@@ -192,6 +197,10 @@ void ListWidget::append(const String &s, ThemeEngine::FontColor color) {
 	_dataList.push_back(s);
 	_list.push_back(s);
 
+	String lowercase = s;
+	lowercase.toLowercase();
+	_searchList.push_back(lowercase);
+
 	setFilter(_filter, false);
 
 	scrollBarRecalc();
@@ -669,6 +678,10 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	// When the filter was only extended, nothing but the entries matching
+	// the old filter can match the new one.
+	const bool narrow = !_filter.empty() && filt.hasPrefix(_filter);
+
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -679,27 +692,33 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 		// Restrict the list to everything which contains all words in _filter
 		// as substrings, ignoring case.
 
+		StringArray words;
 		Common::StringTokenizer tok(_filter);
-		String tmp;
-		int n = 0;
+		while (!tok.empty())
+			words.push_back(tok.nextToken());
+
+		Common::Array<int> candidates;
+		if (narrow)
+			candidates = _listIndex;
+
+		const int count = narrow ? candidates.size() : _dataList.size();
 
 		_list.clear();
 		_listIndex.clear();
 
-		for (StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
+		for (int i = 0; i < count; ++i) {
+			const int n = narrow ? candidates[i] : i;
 			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+
+			for (StringArray::const_iterator word = words.begin(); word != words.end(); ++word) {
+				if (!_searchList[n].contains(*word)) {
 					matches = false;
 					break;
 				}
 			}
 
 			if (matches) {
-				_list.push_back(*i);
+				_list.push_back(_dataList[n]);
 				_listIndex.push_back(n);
 			}
 		}
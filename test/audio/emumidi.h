@@ -0,0 +1,86 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/emumidi.h"
+
+// A driver whose output is the value of the last controller message it got
+class LevelMidiDriver : public MidiDriver_Emulated {
+public:
+	LevelMidiDriver() : MidiDriver_Emulated(0), _level(0), _tick(0) {
+		_baseFreq = 100;
+	}
+
+	void close() {}
+	void send(uint32 b) { _level = (b >> 16) & 0x7F; }
+	MidiChannel *allocateChannel() { return 0; }
+	MidiChannel *getPercussionChannel() { return 0; }
+
+	bool isStereo() const { return false; }
+	int getRate() const { return 1000; }
+
+	int _level;
+	int _tick;
+
+protected:
+	void generateSamples(int16 *buf, int len) {
+		for (int i = 0; i < len; i++)
+			buf[i] = _level;
+	}
+};
+
+class EmulatedMidiDriverTestSuite : public CxxTest::TestSuite {
+	// Send one event per tick, each one 3 ms further into the tick
+	static void timerProc(void *param) {
+		LevelMidiDriver *driver = (LevelMidiDriver *)param;
+
+		if (driver->_tick < 3) {
+			driver->setEventDelay(driver->_tick * 3000 + 3000);
+			driver->send(0x07B0 | ((driver->_tick + 1) << 16));
+		}
+
+		driver->_tick++;
+	}
+
+	void checkLevels(int bufferSize) {
+		LevelMidiDriver driver;
+		driver.open();
+		driver.setTimerCallback(&driver, timerProc);
+
+		int16 output[40];
+		for (int pos = 0; pos < ARRAYSIZE(output); pos += bufferSize)
+			TS_ASSERT_EQUALS(driver.readBuffer(output + pos, bufferSize), bufferSize);
+
+		// At 1 kHz, the ticks start at samples 0, 10 and 20, so the events
+		// are due at samples 3, 16 and 29.
+		for (int i = 0; i < ARRAYSIZE(output); i++) {
+			const int expected = (i < 3) ? 0 : (i < 16) ? 1 : (i < 29) ? 2 : 3;
+			TS_ASSERT_EQUALS(output[i], expected);
+		}
+	}
+
+public:
+	void test_event_position() {
+		checkLevels(40);
+	}
+
+	void test_event_position_small_buffers() {
+		// Events fall beyond the end of the mixer buffer
+		checkLevels(4);
+		checkLevels(1);
+	}
+
+	void test_event_outside_timer() {
+		LevelMidiDriver driver;
+		driver.open();
+
+		int16 output[20];
+		driver.readBuffer(output, 10);
+
+		// Without a timer callback, the delay has no meaning
+		driver.setEventDelay(5000);
+		driver.send(0x07B0 | (42 << 16));
+		driver.readBuffer(output + 10, 10);
+
+		for (int i = 0; i < ARRAYSIZE(output); i++)
+			TS_ASSERT_EQUALS(output[i], (i < 10) ? 0 : 42);
+	}
+};
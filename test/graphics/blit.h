@@ -0,0 +1,399 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/str.h"
+#include "graphics/blit.h"
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+
+#include <sys/time.h>
+
+class BlitTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 29,
+		kHeight = 7,
+		kPitch = 4 * (kWidth + 3)
+	};
+
+	static void fillRandom(byte *buf, uint size, uint32 seed) {
+		for (uint i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			buf[i] = seed >> 16;
+		}
+	}
+
+	static uint32 readPixel(const byte *ptr, int bpp) {
+		return (bpp == 2) ? *(const uint16 *)ptr : *(const uint32 *)ptr;
+	}
+
+	static void writePixel(byte *ptr, int bpp, uint32 color) {
+		if (bpp == 2)
+			*(uint16 *)ptr = color;
+		else
+			*(uint32 *)ptr = color;
+	}
+
+	static Graphics::PixelFormat format(int n) {
+		switch (n) {
+		case 0: return Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);  // RGB565
+		case 1: return Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0);  // RGB555
+		case 2: return Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0);  // XRGB8888
+		case 3: return Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24); // ARGB8888
+		case 4: return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0); // RGBA8888
+		default: return Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0); // RGBA4444
+		}
+	}
+
+public:
+	void test_convert() {
+		byte src[kPitch * kHeight], dst[kPitch * kHeight];
+
+		for (int i = 0; i < 5; i++) {
+			for (int j = 0; j < 5; j++) {
+				const Graphics::PixelFormat srcFmt = format(i), dstFmt = format(j);
+
+				fillRandom(src, sizeof(src), i * 5 + j);
+				memset(dst, 0xA5, sizeof(dst));
+
+				TS_ASSERT(Graphics::convertBlit(dst, src, kPitch, kPitch, kWidth, kHeight, dstFmt, srcFmt));
+
+				for (int y = 0; y < kHeight; y++) {
+					for (int x = 0; x < kWidth + 3; x++) {
+						const uint32 color = readPixel(src + y * kPitch + x * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel);
+
+						byte a, r, g, b;
+						srcFmt.colorToARGB(color, a, r, g, b);
+						uint32 expected = dstFmt.ARGBToColor(a, r, g, b);
+
+						// Equal formats are copied, including unused bits
+						if (i == j)
+							expected = color;
+						if (x >= kWidth)
+							expected = (dstFmt.bytesPerPixel == 2) ? 0xA5A5 : 0xA5A5A5A5;
+
+						TS_ASSERT_EQUALS(readPixel(dst + y * kPitch + x * dstFmt.bytesPerPixel, dstFmt.bytesPerPixel), expected);
+					}
+				}
+			}
+		}
+	}
+
+	void test_convert_unsupported() {
+		byte src[kPitch * kHeight], dst[kPitch * kHeight];
+		memset(dst, 0xA5, sizeof(dst));
+
+		TS_ASSERT(!Graphics::convertBlit(dst, src, kPitch, kPitch, kWidth, kHeight, format(5), format(0)));
+		TS_ASSERT(!Graphics::convertBlit(dst, src, kPitch, kPitch, kWidth, kHeight, format(0), format(5)));
+
+		for (uint i = 0; i < sizeof(dst); i++)
+			TS_ASSERT_EQUALS(dst[i], 0xA5);
+	}
+
+	void test_crossblit_generic() {
+		// RGBA4444 has no specialized conversion, so this takes the generic path
+		byte src[kPitch * kHeight], dst[kPitch * kHeight];
+		fillRandom(src, sizeof(src), 42);
+
+		const Graphics::PixelFormat srcFmt = format(5), dstFmt = format(3);
+		TS_ASSERT(Graphics::crossBlit(dst, src, kPitch, kPitch / 2, kWidth, kHeight, dstFmt, srcFmt));
+
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				byte a, r, g, b;
+				srcFmt.colorToARGB(readPixel(src + y * kPitch / 2 + x * 2, 2), a, r, g, b);
+				TS_ASSERT_EQUALS(readPixel(dst + y * kPitch + x * 4, 4), dstFmt.ARGBToColor(a, r, g, b));
+			}
+		}
+	}
+
+	void test_crossblit_24bit() {
+		// 3 byte pixels used to be read with a 2 byte step
+		const byte src[] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99 };
+		uint32 dst[3];
+
+		const Graphics::PixelFormat srcFmt(3, 8, 8, 8, 0, 16, 8, 0, 0);
+		const Graphics::PixelFormat dstFmt = format(2);
+		TS_ASSERT(Graphics::crossBlit((byte *)dst, src, sizeof(dst), sizeof(src), 3, 1, dstFmt, srcFmt));
+
+		for (int x = 0; x < 3; x++) {
+			uint32 color = 0;
+			byte *col = (byte *)&color;
+#ifdef SCUMM_BIG_ENDIAN
+			col++;
+#endif
+			memcpy(col, src + x * 3, 3);
+
+			byte a, r, g, b;
+			srcFmt.colorToARGB(color, a, r, g, b);
+			TS_ASSERT_EQUALS(dst[x], dstFmt.ARGBToColor(a, r, g, b));
+		}
+	}
+
+	void test_clut() {
+		byte palette[256 * 3];
+		fillRandom(palette, sizeof(palette), 7);
+
+		byte src[kWidth * kHeight];
+		fillRandom(src, sizeof(src), 8);
+
+		for (int i = 0; i < 5; i++) {
+			const Graphics::PixelFormat dstFmt = format(i);
+			byte dst[kPitch * kHeight];
+
+			TS_ASSERT(Graphics::clutBlit(dst, src, kPitch, kWidth, kWidth, kHeight, palette, dstFmt));
+
+			for (int y = 0; y < kHeight; y++) {
+				for (int x = 0; x < kWidth; x++) {
+					const byte *color = palette + src[y * kWidth + x] * 3;
+					TS_ASSERT_EQUALS(readPixel(dst + y * kPitch + x * dstFmt.bytesPerPixel, dstFmt.bytesPerPixel),
+					                 dstFmt.RGBToColor(color[0], color[1], color[2]));
+				}
+			}
+		}
+
+		byte dst[kPitch * kHeight];
+		TS_ASSERT(!Graphics::clutBlit(dst, src, kPitch, kWidth, kWidth, kHeight, palette, Graphics::PixelFormat::createFormatCLUT8()));
+	}
+
+	void test_key() {
+		for (int bpp = 1; bpp <= 4; bpp *= 2) {
+			byte src[kPitch * kHeight], dst[kPitch * kHeight], ref[kPitch * kHeight];
+			fillRandom(src, sizeof(src), bpp);
+			fillRandom(dst, sizeof(dst), bpp + 10);
+			memcpy(ref, dst, sizeof(dst));
+
+			// Make every third pixel transparent
+			const uint32 key = (bpp == 1) ? 0x42 : 0x4242;
+			for (int i = 0; i < kPitch * kHeight / bpp; i += 3) {
+				if (bpp == 1)
+					src[i] = key;
+				else
+					writePixel(src + i * bpp, bpp, key);
+			}
+
+			Graphics::keyBlit(dst, src, kPitch, kPitch, kWidth, kHeight, bpp, key);
+
+			for (int y = 0; y < kHeight; y++) {
+				for (int x = 0; x < kPitch / bpp; x++) {
+					const int offset = y * kPitch + x * bpp;
+					const uint32 color = (bpp == 1) ? src[offset] : readPixel(src + offset, bpp);
+					const byte *expected = (x < kWidth && color != key) ? src : ref;
+					TS_ASSERT_SAME_DATA(dst + offset, expected + offset, bpp);
+				}
+			}
+		}
+	}
+
+	void test_fill() {
+		// Odd offsets and widths check the unaligned start and end of rows
+		const uint32 colors[] = { 0x12345678, 0x77777777, 0xABAB };
+
+		for (int bpp = 1; bpp <= 4; bpp *= 2) {
+			for (int c = 0; c < ARRAYSIZE(colors); c++) {
+				for (int offset = 0; offset < 3; offset++) {
+					byte buf[kPitch * kHeight], ref[kPitch * kHeight];
+					memset(buf, 0xA5, sizeof(buf));
+					memset(ref, 0xA5, sizeof(ref));
+
+					const int w = kWidth - offset;
+					for (int y = 1; y < kHeight - 1; y++) {
+						for (int x = offset; x < offset + w; x++) {
+							if (bpp == 1)
+								ref[y * kPitch + x] = colors[c];
+							else
+								writePixel(ref + y * kPitch + x * bpp, bpp, colors[c]);
+						}
+					}
+
+					Graphics::fillBlit(buf + kPitch + offset * bpp, kPitch, w, kHeight - 2, bpp, colors[c]);
+					TS_ASSERT_SAME_DATA(buf, ref, sizeof(buf));
+				}
+			}
+		}
+	}
+
+	void test_scale_box() {
+		// Every 2x2 box of the source becomes one pixel, averaging the boxes
+		const byte src[4 * 4] = {
+			0, 1, 2, 2,
+			1, 0, 2, 2,
+			3, 3, 0, 0,
+			3, 3, 0, 1
+		};
+		byte palette[256 * 3];
+		memset(palette, 0, sizeof(palette));
+		palette[1 * 3] = 200;     // red
+		palette[2 * 3 + 1] = 100; // green
+		palette[3 * 3 + 2] = 255; // blue
+
+		const Graphics::PixelFormat dstFmt = format(2);
+		uint32 dst[2 * 2];
+		TS_ASSERT(Graphics::scaleBlit((byte *)dst, src, 2 * 4, 4, 2, 2, 4, 4, dstFmt, Graphics::PixelFormat::createFormatCLUT8(), palette));
+
+		TS_ASSERT_EQUALS(dst[0], dstFmt.RGBToColor(100, 0, 0));
+		TS_ASSERT_EQUALS(dst[1], dstFmt.RGBToColor(0, 100, 0));
+		TS_ASSERT_EQUALS(dst[2], dstFmt.RGBToColor(0, 0, 255));
+		TS_ASSERT_EQUALS(dst[3], dstFmt.RGBToColor(50, 0, 0));
+	}
+
+	void test_scale_ratios() {
+		// Compare with averaging every box on its own, for ratios which don't
+		// divide evenly, and for scaling up
+		const Graphics::PixelFormat srcFmt = format(3), dstFmt = format(2);
+		const int sizes[][4] = { { 7, 5, 3, 2 }, { 29, 7, 8, 3 }, { 3, 2, 7, 5 } };
+
+		byte src[kPitch * kHeight];
+		fillRandom(src, sizeof(src), 1234);
+
+		for (int i = 0; i < ARRAYSIZE(sizes); i++) {
+			const int srcW = sizes[i][0], srcH = sizes[i][1], dstW = sizes[i][2], dstH = sizes[i][3];
+
+			uint32 dst[kPitch * kHeight];
+			TS_ASSERT(Graphics::scaleBlit((byte *)dst, src, dstW * 4, kPitch, dstW, dstH, srcW, srcH, dstFmt, srcFmt));
+
+			for (int y = 0; y < dstH; y++) {
+				for (int x = 0; x < dstW; x++) {
+					const int x1 = x * srcW / dstW, x2 = MAX((x + 1) * srcW / dstW, x1 + 1);
+					const int y1 = y * srcH / dstH, y2 = MAX((y + 1) * srcH / dstH, y1 + 1);
+
+					uint32 sumR = 0, sumG = 0, sumB = 0;
+					for (int sy = y1; sy < y2; sy++) {
+						for (int sx = x1; sx < x2; sx++) {
+							byte r, g, b;
+							srcFmt.colorToRGB(readPixel(src + sy * kPitch + sx * 4, 4), r, g, b);
+							sumR += r;
+							sumG += g;
+							sumB += b;
+						}
+					}
+
+					const uint32 count = (x2 - x1) * (y2 - y1);
+					TS_ASSERT_EQUALS(dst[y * dstW + x], dstFmt.RGBToColor((sumR + count / 2) / count,
+					                                                      (sumG + count / 2) / count,
+					                                                      (sumB + count / 2) / count));
+				}
+			}
+		}
+
+		uint32 dst;
+		TS_ASSERT(!Graphics::scaleBlit((byte *)&dst, src, 4, kPitch, 1, 1, 2, 2, dstFmt, Graphics::PixelFormat::createFormatCLUT8()));
+	}
+
+	void test_copy() {
+		byte src[kPitch * kHeight], dst[kPitch * kHeight];
+		fillRandom(src, sizeof(src), 99);
+		memset(dst, 0, sizeof(dst));
+
+		Graphics::copyBlit(dst, src, kPitch, kPitch, kWidth, kHeight, 2);
+
+		for (int y = 0; y < kHeight; y++) {
+			TS_ASSERT_SAME_DATA(dst + y * kPitch, src + y * kPitch, kWidth * 2);
+
+			for (int x = kWidth * 2; x < kPitch; x++)
+				TS_ASSERT_EQUALS(dst[y * kPitch + x], 0);
+		}
+	}
+};
+
+/**
+ * Throughput of the blit routines on a 640x480 screen, compared to
+ * converting every pixel through colorToARGB() and ARGBToColor(). The
+ * results are reported as traces; there are no assertions on them, as
+ * the numbers depend on the machine.
+ */
+class BlitBenchmarkTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 640,
+		kHeight = 480,
+		kIterations = 10
+	};
+
+	byte *_src, *_dst;
+	Common::String _report;
+
+	static uint32 getMicros() {
+		timeval curTime;
+		gettimeofday(&curTime, 0);
+		return (uint32)(curTime.tv_sec * 1000000 + curTime.tv_usec);
+	}
+
+	void report(const char *name, uint32 micros) {
+		// Megapixels per second
+		const uint32 pixels = kWidth * kHeight * kIterations;
+		_report += Common::String::format(" %s %u", name, micros ? pixels / micros : pixels);
+	}
+
+	static void convertGeneric(byte *dst, const byte *src, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		const uint16 *s = (const uint16 *)src;
+		uint32 *d = (uint32 *)dst;
+
+		for (int i = 0; i < kWidth * kHeight; i++) {
+			byte a, r, g, b;
+			srcFmt.colorToARGB(s[i], a, r, g, b);
+			d[i] = dstFmt.ARGBToColor(a, r, g, b);
+		}
+	}
+
+public:
+	void setUp() {
+		_src = new byte[kWidth * kHeight * 4];
+		_dst = new byte[kWidth * kHeight * 4];
+		memset(_src, 0x5A, kWidth * kHeight * 4);
+		_report = "Mpixels/s:";
+	}
+
+	void tearDown() {
+		delete[] _src;
+		delete[] _dst;
+	}
+
+	void test_throughput() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat rgb555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+
+		byte palette[256 * 3];
+		memset(palette, 0x33, sizeof(palette));
+
+		uint32 start = getMicros();
+		for (int i = 0; i < kIterations; i++)
+			convertGeneric(_dst, _src, argb8888, rgb565);
+		report("generic565to8888", getMicros() - start);
+
+		start = getMicros();
+		for (int i = 0; i < kIterations; i++)
+			Graphics::crossBlit(_dst, _src, kWidth * 4, kWidth * 2, kWidth, kHeight, argb8888, rgb565);
+		report("565to8888", getMicros() - start);
+
+		start = getMicros();
+		for (int i = 0; i < kIterations; i++)
+			Graphics::crossBlit(_dst, _src, kWidth * 2, kWidth * 2, kWidth, kHeight, rgb555, rgb565);
+		report("565to555", getMicros() - start);
+
+		start = getMicros();
+		for (int i = 0; i < kIterations; i++)
+			Graphics::clutBlit(_dst, _src, kWidth * 2, kWidth, kWidth, kHeight, palette, rgb565);
+		report("clut8to565", getMicros() - start);
+
+		start = getMicros();
+		for (int i = 0; i < kIterations; i++)
+			Graphics::clutBlit(_dst, _src, kWidth * 4, kWidth, kWidth, kHeight, palette, argb8888);
+		report("clut8to8888", getMicros() - start);
+
+		start = getMicros();
+		for (int i = 0; i < kIterations; i++)
+			Graphics::keyBlit(_dst, _src, kWidth * 2, kWidth * 2, kWidth, kHeight, 2, 0x1234);
+		report("key16", getMicros() - start);
+
+		start = getMicros();
+		for (int i = 0; i < kIterations; i++)
+			Graphics::fillBlit(_dst, kWidth * 2, kWidth, kHeight, 2, 0x1234);
+		report("fill16", getMicros() - start);
+
+		start = getMicros();
+		for (int i = 0; i < kIterations; i++)
+			Graphics::scaleBlit(_dst, _src, 160 * 2, kWidth, 160, 120, kWidth, kHeight, rgb565, Graphics::PixelFormat::createFormatCLUT8(), palette);
+		report("scaleclut8to565", getMicros() - start);
+
+		TS_TRACE(_report.c_str());
+	}
+};
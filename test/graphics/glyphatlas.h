@@ -0,0 +1,154 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/str.h"
+#include "graphics/font.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "graphics/fonts/glyphatlas.h"
+
+// A font whose characters are all as wide as it is told
+class FixedWidthFont : public Graphics::Font {
+public:
+	FixedWidthFont(int width) : _width(width) {}
+
+	int getFontHeight() const { return 8; }
+	int getMaxCharWidth() const { return _width; }
+	int getCharWidth(byte chr) const { return _width; }
+	void drawChar(Graphics::Surface *dst, byte chr, int x, int y, uint32 color) const {}
+
+	void setWidth(int width) {
+		_width = width;
+		clearLayoutCache();
+	}
+
+private:
+	int _width;
+};
+
+class GlyphAtlasTestSuite : public CxxTest::TestSuite {
+	enum {
+		kGlyphWidth = 7,
+		kGlyphHeight = 5
+	};
+
+	byte _mask[kGlyphWidth * kGlyphHeight];
+
+	void fillMask() {
+		uint32 seed = 0x4321;
+
+		for (int i = 0; i < ARRAYSIZE(_mask); i++) {
+			seed = seed * 1103515245 + 12345;
+			_mask[i] = (seed >> 16) & 1;
+		}
+
+		// Make sure runs touch both edges
+		_mask[0] = 1;
+		_mask[kGlyphWidth - 1] = 1;
+	}
+
+	static uint32 readPixel(const Graphics::Surface &surface, int x, int y) {
+		const byte *ptr = (const byte *)surface.getBasePtr(x, y);
+
+		if (surface.format.bytesPerPixel == 1)
+			return *ptr;
+		else if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)ptr;
+		return *(const uint32 *)ptr;
+	}
+
+	void checkDraw(const Graphics::PixelFormat &format, int gx, int gy) {
+		fillMask();
+
+		Graphics::GlyphAtlas atlas;
+		atlas.addGlyph(300, _mask, kGlyphWidth, kGlyphHeight, kGlyphWidth);
+		TS_ASSERT(atlas.hasGlyph(300));
+		TS_ASSERT(!atlas.hasGlyph(30));
+
+		Graphics::Surface surface;
+		surface.create(10, 8, format);
+		memset(surface.pixels, 0, surface.pitch * surface.h);
+
+		const uint32 color = (format.bytesPerPixel == 1) ? 0xA5 : 0xA5C3;
+		atlas.drawGlyph(&surface, 300, gx, gy, color);
+
+		for (int y = 0; y < surface.h; y++) {
+			for (int x = 0; x < surface.w; x++) {
+				const int mx = x - gx, my = y - gy;
+				const bool set = mx >= 0 && mx < kGlyphWidth && my >= 0 && my < kGlyphHeight
+				                 && _mask[my * kGlyphWidth + mx];
+
+				TS_ASSERT_EQUALS(readPixel(surface, x, y), set ? color : 0);
+			}
+		}
+
+		surface.free();
+	}
+
+	void checkAllPositions(const Graphics::PixelFormat &format) {
+		// Inside, and clipped at every edge
+		checkDraw(format, 1, 1);
+		checkDraw(format, -3, -2);
+		checkDraw(format, 6, 5);
+		checkDraw(format, -8, 0);
+		checkDraw(format, 0, 9);
+	}
+
+public:
+	void test_draw_clut8() {
+		checkAllPositions(Graphics::PixelFormat::createFormatCLUT8());
+	}
+
+	void test_draw_rgb565() {
+		checkAllPositions(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_draw_xrgb8888() {
+		checkAllPositions(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0));
+	}
+
+	void test_clear() {
+		fillMask();
+
+		Graphics::GlyphAtlas atlas;
+		atlas.addGlyph('a', _mask, kGlyphWidth, kGlyphHeight, kGlyphWidth);
+		atlas.addGlyph(0x8140, _mask, kGlyphWidth, kGlyphHeight, kGlyphWidth);
+		TS_ASSERT_EQUALS(atlas.getGlyphCount(), 2u);
+
+		atlas.clear();
+		TS_ASSERT_EQUALS(atlas.getGlyphCount(), 0u);
+		TS_ASSERT(!atlas.hasGlyph('a'));
+		TS_ASSERT(!atlas.hasGlyph(0x8140));
+	}
+
+	void test_word_wrap_cache() {
+		const Common::String text = "one two three four";
+
+		FixedWidthFont font(6);
+		Common::Array<Common::String> lines;
+		const int width = font.wordWrapText(text, 60, lines);
+		TS_ASSERT(lines.size() > 1);
+
+		// A cached result is appended just like a fresh one
+		TS_ASSERT_EQUALS(font.wordWrapText(text, 60, lines), width);
+		TS_ASSERT_EQUALS(lines.size(), 2 * (lines.size() / 2));
+		for (uint i = 0; i < lines.size() / 2; i++)
+			TS_ASSERT_EQUALS(lines[i + lines.size() / 2], lines[i]);
+
+		// Results for other widths don't get mixed up with it
+		lines.clear();
+		TS_ASSERT_EQUALS(font.wordWrapText(text, 200, lines), (int)text.size() * 6);
+		TS_ASSERT_EQUALS(lines.size(), 1u);
+
+		// Changing the font has to invalidate the cache
+		font.setWidth(12);
+		FixedWidthFont wideFont(12);
+
+		Common::Array<Common::String> expected;
+		lines.clear();
+		TS_ASSERT_EQUALS(font.wordWrapText(text, 200, lines), wideFont.wordWrapText(text, 200, expected));
+		TS_ASSERT_EQUALS(lines.size(), expected.size());
+		for (uint i = 0; i < MIN(lines.size(), expected.size()); i++)
+			TS_ASSERT_EQUALS(lines[i], expected[i]);
+	}
+};
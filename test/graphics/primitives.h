@@ -0,0 +1,123 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/primitives.h"
+
+class FloodFillTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 37,
+		kHeight = 23
+	};
+
+	struct GridFiller {
+		byte *pixels;
+		byte search;
+		byte fill;
+
+		bool isFillable(int x, int y) {
+			return pixels[y * kWidth + x] == search;
+		}
+
+		void fillSpan(int x1, int x2, int y) {
+			for (int x = x1; x <= x2; x++)
+				pixels[y * kWidth + x] = fill;
+		}
+	};
+
+	// Fills pixel by pixel, visiting the 4 neighbours of every filled pixel
+	static void referenceFill(byte *pixels, int x, int y, int left, int top, int right, int bottom, byte search, byte fill) {
+		Common::Array<Common::Point> todo;
+		todo.push_back(Common::Point(x, y));
+
+		while (!todo.empty()) {
+			const Common::Point p = todo.back();
+			todo.pop_back();
+
+			if (p.x < left || p.x > right || p.y < top || p.y > bottom || pixels[p.y * kWidth + p.x] != search)
+				continue;
+
+			pixels[p.y * kWidth + p.x] = fill;
+			todo.push_back(Common::Point(p.x - 1, p.y));
+			todo.push_back(Common::Point(p.x + 1, p.y));
+			todo.push_back(Common::Point(p.x, p.y - 1));
+			todo.push_back(Common::Point(p.x, p.y + 1));
+		}
+	}
+
+	static void makeMaze(byte *pixels, uint32 seed) {
+		for (int i = 0; i < kWidth * kHeight; i++) {
+			seed = seed * 1103515245 + 12345;
+			// About a third of the pixels are walls, some of another color
+			const uint32 r = (seed >> 16) % 9;
+			pixels[i] = (r < 2) ? 1 : ((r < 3) ? 2 : 0);
+		}
+	}
+
+public:
+	void test_matches_reference_fill() {
+		byte pixels[kWidth * kHeight];
+		byte expected[kWidth * kHeight];
+
+		for (uint32 seed = 1; seed <= 50; seed++) {
+			makeMaze(pixels, seed);
+			memcpy(expected, pixels, sizeof(pixels));
+
+			const int x = (seed * 7) % kWidth;
+			const int y = (seed * 3) % kHeight;
+
+			GridFiller filler;
+			filler.pixels = pixels;
+			filler.search = pixels[y * kWidth + x];
+			filler.fill = 5;
+
+			Graphics::floodFill(x, y, 0, 0, kWidth - 1, kHeight - 1, filler);
+			referenceFill(expected, x, y, 0, 0, kWidth - 1, kHeight - 1, filler.search, filler.fill);
+
+			TS_ASSERT_EQUALS(memcmp(pixels, expected, sizeof(pixels)), 0);
+		}
+	}
+
+	void test_respects_borders() {
+		byte pixels[kWidth * kHeight];
+		byte expected[kWidth * kHeight];
+
+		memset(pixels, 0, sizeof(pixels));
+		memcpy(expected, pixels, sizeof(pixels));
+
+		GridFiller filler;
+		filler.pixels = pixels;
+		filler.search = 0;
+		filler.fill = 3;
+
+		Graphics::floodFill(10, 10, 4, 5, 20, 15, filler);
+		referenceFill(expected, 10, 10, 4, 5, 20, 15, 0, 3);
+
+		TS_ASSERT_EQUALS(memcmp(pixels, expected, sizeof(pixels)), 0);
+		TS_ASSERT_EQUALS(pixels[5 * kWidth + 4], 3);
+		TS_ASSERT_EQUALS(pixels[15 * kWidth + 20], 3);
+		TS_ASSERT_EQUALS(pixels[4 * kWidth + 4], 0);
+		TS_ASSERT_EQUALS(pixels[5 * kWidth + 21], 0);
+	}
+
+	void test_start_outside_borders() {
+		byte pixels[kWidth * kHeight];
+		memset(pixels, 0, sizeof(pixels));
+
+		GridFiller filler;
+		filler.pixels = pixels;
+		filler.search = 0;
+		filler.fill = 3;
+
+		Graphics::floodFill(2, 2, 4, 5, 20, 15, filler);
+
+		// As in Sierra's SCI fill, the start point isn't checked against the
+		// borders: the fill spreads right up to the right border and down
+		// to the bottom border, but not left or up from the start point
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				const byte expected = (x >= 2 && x <= 20 && y >= 2 && y <= 15) ? 3 : 0;
+				TS_ASSERT_EQUALS(pixels[y * kWidth + x], expected);
+			}
+		}
+	}
+};
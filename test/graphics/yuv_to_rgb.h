@@ -0,0 +1,107 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/util.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 24,
+		kHeight = 16,
+		kPadding = 5
+	};
+
+	byte _y[(kWidth + kPadding) * kHeight];
+	byte _u[(kWidth + kPadding) * kHeight];
+	byte _v[(kWidth + kPadding) * kHeight];
+
+	void fillPlanes() {
+		uint32 seed = 0x1234;
+
+		for (int i = 0; i < ARRAYSIZE(_y); i++) {
+			seed = seed * 1103515245 + 12345;
+			_y[i] = seed >> 16;
+			seed = seed * 1103515245 + 12345;
+			_u[i] = seed >> 16;
+			seed = seed * 1103515245 + 12345;
+			_v[i] = seed >> 16;
+		}
+
+		// Make sure the extremes are covered as well
+		_y[0] = 0;   _u[0] = 0;   _v[0] = 0;
+		_y[1] = 255; _u[1] = 255; _v[1] = 255;
+	}
+
+	// The color the lookup tables in graphics/yuv_to_rgb.cpp produce
+	static uint32 referencePixel(const Graphics::PixelFormat &format, byte y, byte u, byte v) {
+		int16 cr = v - 128;
+		int16 cb = u - 128;
+
+		int r = y + (int16)( (0.419 / 0.299) * cr);
+		int g = y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb);
+		int b = y + (int16)( (0.587 / 0.331) * cb);
+
+		return format.RGBToColor(CLIP(r, 0, 255), CLIP(g, 0, 255), CLIP(b, 0, 255));
+	}
+
+	static uint32 readPixel(const Graphics::Surface &surface, int x, int y) {
+		const byte *ptr = (const byte *)surface.getBasePtr(x, y);
+
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)ptr;
+		return *(const uint32 *)ptr;
+	}
+
+	typedef void (*ConvertFunc)(Graphics::Surface *, const byte *, const byte *, const byte *, int, int, int, int);
+
+	void checkConversion(const Graphics::PixelFormat &format, ConvertFunc convert, int hShift, int vShift) {
+		fillPlanes();
+
+		// Make the surface bigger than the image, to check that the
+		// conversion keeps to the pitch and leaves the rest alone
+		Graphics::Surface surface;
+		surface.create(kWidth + 3, kHeight + 2, format);
+		memset(surface.pixels, 0xA5, surface.pitch * surface.h);
+
+		const int pitch = kWidth + kPadding;
+		convert(&surface, _y, _u, _v, kWidth, kHeight, pitch, pitch);
+
+		const uint32 untouched = readPixel(surface, kWidth + 2, kHeight + 1);
+
+		for (int y = 0; y < surface.h; y++) {
+			for (int x = 0; x < surface.w; x++) {
+				uint32 expected = untouched;
+
+				if (x < kWidth && y < kHeight) {
+					const int uvOffset = (y >> vShift) * pitch + (x >> hShift);
+					expected = referencePixel(format, _y[y * pitch + x], _u[uvOffset], _v[uvOffset]);
+				}
+
+				TS_ASSERT_EQUALS(readPixel(surface, x, y), expected);
+			}
+		}
+
+		surface.free();
+	}
+
+	void checkAllFormats(ConvertFunc convert, int hShift, int vShift) {
+		// RGB565, RGB555 and XRGB8888
+		checkConversion(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), convert, hShift, vShift);
+		checkConversion(Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0), convert, hShift, vShift);
+		checkConversion(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0), convert, hShift, vShift);
+	}
+
+public:
+	void test_yuv420() {
+		checkAllFormats(Graphics::convertYUV420ToRGB, 1, 1);
+	}
+
+	void test_yuv422() {
+		checkAllFormats(Graphics::convertYUV422ToRGB, 1, 0);
+	}
+
+	void test_yuv410() {
+		checkAllFormats(Graphics::convertYUV410ToRGB, 2, 2);
+	}
+};
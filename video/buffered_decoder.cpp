@@ -0,0 +1,294 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "video/buffered_decoder.h"
+
+#include "common/system.h"
+
+namespace Video {
+
+BufferedVideoDecoder::BufferedVideoDecoder(VideoDecoder *decoder, uint queueSize,
+		DisposeAfterUse::Flag disposeDecoder) : _decoder(decoder), _disposeDecoder(disposeDecoder) {
+
+	assert(_decoder);
+
+	_frames.resize(MAX<uint>(queueSize, 1));
+	_queueHead = 0;
+	_queuedCount = 0;
+
+	memset(_palette, 0, sizeof(_palette));
+	_dirtyPalette = false;
+
+	_droppedFrames = 0;
+
+	// Take over the palette of an already loaded video
+	if (_decoder->isVideoLoaded())
+		updatePalette(_palette, _dirtyPalette);
+}
+
+BufferedVideoDecoder::~BufferedVideoDecoder() {
+	freeFrames();
+
+	if (_disposeDecoder == DisposeAfterUse::YES)
+		delete _decoder;
+}
+
+void BufferedVideoDecoder::freeFrames() {
+	flush();
+
+	for (uint i = 0; i < _frames.size(); i++)
+		_frames[i].surface.free();
+
+	_surface.free();
+}
+
+bool BufferedVideoDecoder::loadStream(Common::SeekableReadStream *stream) {
+	close();
+
+	if (!_decoder->loadStream(stream))
+		return false;
+
+	updatePalette(_palette, _dirtyPalette);
+	return true;
+}
+
+void BufferedVideoDecoder::close() {
+	freeFrames();
+
+	_decoder->close();
+	_dirtyPalette = false;
+}
+
+bool BufferedVideoDecoder::isVideoLoaded() const {
+	return _decoder->isVideoLoaded();
+}
+
+uint16 BufferedVideoDecoder::getWidth() const {
+	return _decoder->getWidth();
+}
+
+uint16 BufferedVideoDecoder::getHeight() const {
+	return _decoder->getHeight();
+}
+
+Graphics::PixelFormat BufferedVideoDecoder::getPixelFormat() const {
+	return _decoder->getPixelFormat();
+}
+
+const byte *BufferedVideoDecoder::getPalette() {
+	_dirtyPalette = false;
+	return _palette;
+}
+
+bool BufferedVideoDecoder::hasDirtyPalette() const {
+	return _dirtyPalette;
+}
+
+int32 BufferedVideoDecoder::getCurFrame() const {
+	return _decoder->getCurFrame() - _queuedCount;
+}
+
+uint32 BufferedVideoDecoder::getFrameCount() const {
+	return _decoder->getFrameCount();
+}
+
+uint32 BufferedVideoDecoder::getElapsedTime() const {
+	return _decoder->getElapsedTime();
+}
+
+uint32 BufferedVideoDecoder::getTimeToNextFrame() const {
+	if (_queuedCount == 0)
+		return _decoder->getTimeToNextFrame();
+
+	uint32 elapsedTime = getElapsedTime();
+	uint32 frameTime = queuedFrame(0).showTime;
+
+	if (frameTime <= elapsedTime)
+		return 0;
+
+	return frameTime - elapsedTime;
+}
+
+bool BufferedVideoDecoder::endOfVideo() const {
+	return (_queuedCount == 0) && _decoder->endOfVideo();
+}
+
+const Graphics::Surface *BufferedVideoDecoder::decodeNextFrame() {
+	if (_queuedCount == 0) {
+		// Copy the frame, as the wrapped decoder's buffer is overwritten by
+		// the next decodeAhead()
+		const Graphics::Surface *surface = _decoder->decodeNextFrame();
+		updatePalette(_palette, _dirtyPalette);
+
+		if (!surface)
+			return 0;
+
+		copySurface(_surface, *surface);
+		return &_surface;
+	}
+
+	// Drop frames that are late, as long as the one after them is due as well
+	uint32 elapsedTime = getElapsedTime();
+	while ((_queuedCount > 1) && (queuedFrame(1).showTime <= elapsedTime)) {
+		Frame &dropped = queuedFrame(0);
+		Frame &next    = queuedFrame(1);
+
+		// Carry over what the next frame would otherwise lose
+		if (dropped.dirtyPalette && !next.dirtyPalette) {
+			memcpy(next.palette, dropped.palette, sizeof(next.palette));
+			next.dirtyPalette = true;
+		}
+		if (dropped.hasSurface && !next.hasSurface) {
+			SWAP(dropped.surface, next.surface);
+			next.hasSurface = true;
+		}
+
+		popFrame();
+		_droppedFrames++;
+	}
+
+	Frame &frame = queuedFrame(0);
+
+	// The frame's buffer is swapped with the one of the previously shown
+	// frame, so that the returned surface stays valid while frames are
+	// decoded into the queue.
+	bool hasSurface = frame.hasSurface;
+	if (hasSurface)
+		SWAP(_surface, frame.surface);
+
+	if (frame.dirtyPalette) {
+		memcpy(_palette, frame.palette, sizeof(_palette));
+		_dirtyPalette = true;
+	}
+
+	popFrame();
+
+	return hasSurface ? &_surface : 0;
+}
+
+uint BufferedVideoDecoder::decodeAhead(uint32 maxMillis) {
+	if ((getCurFrame() < 0) || isPaused())
+		return 0;
+
+	uint32 startTime = g_system->getMillis();
+	uint count = 0;
+
+	while ((_queuedCount < _frames.size()) && !_decoder->endOfVideo()) {
+		if ((g_system->getMillis() - startTime) >= maxMillis)
+			break;
+
+		Frame &frame = queuedFrame(_queuedCount);
+
+		frame.showTime = _decoder->getElapsedTime() + _decoder->getTimeToNextFrame();
+
+		const Graphics::Surface *surface = _decoder->decodeNextFrame();
+
+		frame.hasSurface = surface != 0;
+		if (surface)
+			copySurface(frame.surface, *surface);
+
+		frame.dirtyPalette = false;
+		updatePalette(frame.palette, frame.dirtyPalette);
+
+		_queuedCount++;
+		count++;
+	}
+
+	return count;
+}
+
+void BufferedVideoDecoder::flush() {
+	while (_queuedCount > 0) {
+		// Don't lose a palette change of a frame that was never shown
+		Frame &frame = queuedFrame(0);
+		if (frame.dirtyPalette) {
+			memcpy(_palette, frame.palette, sizeof(_palette));
+			_dirtyPalette = true;
+		}
+
+		popFrame();
+	}
+}
+
+void BufferedVideoDecoder::pauseVideoIntern(bool pause) {
+	_decoder->pauseVideo(pause);
+}
+
+void BufferedVideoDecoder::popFrame() {
+	assert(_queuedCount > 0);
+
+	queuedFrame(0).dirtyPalette = false;
+
+	_queueHead = (_queueHead + 1) % _frames.size();
+	_queuedCount--;
+}
+
+void BufferedVideoDecoder::updatePalette(byte *palette, bool &dirty) {
+	if (!_decoder->hasDirtyPalette())
+		return;
+
+	const byte *decoderPalette = _decoder->getPalette();
+	if (decoderPalette) {
+		memcpy(palette, decoderPalette, 256 * 3);
+		dirty = true;
+	}
+}
+
+void BufferedVideoDecoder::copySurface(Graphics::Surface &dst, const Graphics::Surface &src) {
+	if ((dst.w != src.w) || (dst.h != src.h) || (dst.format != src.format)) {
+		dst.free();
+		dst.create(src.w, src.h, src.format);
+	}
+
+	const uint32 rowSize = src.w * src.format.bytesPerPixel;
+
+	const byte *srcRow = (const byte *)src.pixels;
+	byte *dstRow = (byte *)dst.pixels;
+
+	for (uint16 y = 0; y < src.h; y++) {
+		memcpy(dstRow, srcRow, rowSize);
+
+		srcRow += src.pitch;
+		dstRow += dst.pitch;
+	}
+}
+
+SeekableBufferedVideoDecoder::SeekableBufferedVideoDecoder(SeekableVideoDecoder *decoder,
+		uint queueSize, DisposeAfterUse::Flag disposeDecoder) :
+		BufferedVideoDecoder(decoder, queueSize, disposeDecoder), _seekableDecoder(decoder) {
+}
+
+void SeekableBufferedVideoDecoder::rewind() {
+	flush();
+	_seekableDecoder->rewind();
+}
+
+void SeekableBufferedVideoDecoder::seekToTime(Audio::Timestamp time) {
+	flush();
+	_seekableDecoder->seekToTime(time);
+}
+
+uint32 SeekableBufferedVideoDecoder::getDuration() const {
+	return _seekableDecoder->getDuration();
+}
+
+} // End of namespace Video
@@ -0,0 +1,169 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef VIDEO_BUFFERED_DECODER_H
+#define VIDEO_BUFFERED_DECODER_H
+
+#include "common/array.h"
+#include "common/types.h"
+
+#include "graphics/surface.h"
+
+#include "video/video_decoder.h"
+
+namespace Video {
+
+/**
+ * A VideoDecoder wrapper which decodes frames ahead of time into a small
+ * queue of surfaces, so that a slow frame or a slow disk access can be
+ * absorbed by frames that were decoded while there was time to spare.
+ *
+ * Frames are decoded on the caller's thread, in slices: the caller decides
+ * when to decode ahead by calling decodeAhead() with a time budget, e.g.
+ * instead of sleeping in its video loop. decodeNextFrame() then returns
+ * the next queued frame, or decodes one directly if the queue is empty.
+ * Frames which are already late when the following frame is due as well
+ * are dropped.
+ *
+ * The timing (needsUpdate(), getTimeToNextFrame(), getCurFrame()) is that
+ * of the frames returned to the caller, not of the ones decoded ahead.
+ *
+ * Use SeekableBufferedVideoDecoder to wrap a decoder which can seek.
+ */
+class BufferedVideoDecoder : public virtual VideoDecoder {
+public:
+	/**
+	 * Create a wrapper around a decoder.
+	 *
+	 * @param decoder        the decoder to wrap
+	 * @param queueSize      the maximum number of frames to decode ahead
+	 * @param disposeDecoder whether to delete the wrapped decoder with the wrapper
+	 */
+	BufferedVideoDecoder(VideoDecoder *decoder, uint queueSize = 4,
+			DisposeAfterUse::Flag disposeDecoder = DisposeAfterUse::YES);
+	~BufferedVideoDecoder();
+
+	bool loadStream(Common::SeekableReadStream *stream);
+	void close();
+	bool isVideoLoaded() const;
+
+	uint16 getWidth() const;
+	uint16 getHeight() const;
+	Graphics::PixelFormat getPixelFormat() const;
+
+	const byte *getPalette();
+	bool hasDirtyPalette() const;
+
+	int32 getCurFrame() const;
+	uint32 getFrameCount() const;
+	uint32 getElapsedTime() const;
+	uint32 getTimeToNextFrame() const;
+	bool endOfVideo() const;
+
+	/**
+	 * Return the next frame. The surface is owned by the wrapper and stays
+	 * valid until the next call, regardless of decodeAhead() calls.
+	 */
+	const Graphics::Surface *decodeNextFrame();
+
+	/**
+	 * Decode frames into the queue until it is full or the given time
+	 * has been used up. Nothing is decoded before the first frame has
+	 * been returned by decodeNextFrame(), or while the video is paused.
+	 *
+	 * @param maxMillis the time that may be spent decoding
+	 * @return the number of frames that were decoded
+	 */
+	uint decodeAhead(uint32 maxMillis);
+
+	/** Discard all frames that were decoded ahead. */
+	void flush();
+
+	/** Return the number of frames currently decoded ahead. */
+	uint getQueueDepth() const { return _queuedCount; }
+
+	/** Return the maximum number of frames that are decoded ahead. */
+	uint getQueueSize() const { return _frames.size(); }
+
+	/** Return the number of frames that were dropped for being late. */
+	uint32 getDroppedFrames() const { return _droppedFrames; }
+
+	/** Reset the dropped frame counter. */
+	void resetDroppedFrames() { _droppedFrames = 0; }
+
+protected:
+	void pauseVideoIntern(bool pause);
+
+private:
+	struct Frame {
+		Graphics::Surface surface;
+		bool hasSurface;   ///< false if the decoder returned no surface for this frame
+		bool dirtyPalette; ///< true if the frame comes with a new palette
+		uint32 showTime;   ///< The elapsed time at which the frame is to be shown
+		byte palette[256 * 3];
+
+		Frame() : hasSurface(false), dirtyPalette(false), showTime(0) {}
+	};
+
+	VideoDecoder *_decoder;
+	DisposeAfterUse::Flag _disposeDecoder;
+
+	Common::Array<Frame> _frames; ///< Ring buffer of frames decoded ahead
+	uint _queueHead;
+	uint _queuedCount;
+
+	Graphics::Surface _surface; ///< The frame last returned by decodeNextFrame()
+	byte _palette[256 * 3];
+	bool _dirtyPalette;
+
+	uint32 _droppedFrames;
+
+	void freeFrames();
+
+	Frame &queuedFrame(uint n) { return _frames[(_queueHead + n) % _frames.size()]; }
+	const Frame &queuedFrame(uint n) const { return _frames[(_queueHead + n) % _frames.size()]; }
+
+	void popFrame();
+	void updatePalette(byte *palette, bool &dirty);
+	static void copySurface(Graphics::Surface &dst, const Graphics::Surface &src);
+};
+
+/**
+ * A BufferedVideoDecoder for decoders which can seek. Seeking and
+ * rewinding flush the queue and are passed on to the wrapped decoder.
+ */
+class SeekableBufferedVideoDecoder : public BufferedVideoDecoder, public SeekableVideoDecoder {
+public:
+	SeekableBufferedVideoDecoder(SeekableVideoDecoder *decoder, uint queueSize = 4,
+			DisposeAfterUse::Flag disposeDecoder = DisposeAfterUse::YES);
+
+	void rewind();
+	void seekToTime(Audio::Timestamp time);
+	uint32 getDuration() const;
+
+private:
+	SeekableVideoDecoder *_seekableDecoder;
+};
+
+} // End of namespace Video
+
+#endif
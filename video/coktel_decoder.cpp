@@ -433,16 +433,17 @@ void CoktelDecoder::deRLE(byte *&destPtr, const byte *&srcPtr, int16 destLen, in
 			destPtr += copyCount;
 			destLen -= copyCount;
 		} else { // 2 bytes tmp times
-			for (int i = 0; (i < tmp) && (destLen > 0); i++) {
-				for (int j = 0; j < 2; j++) {
-					if (destLen <= 0)
-						break;
+			int16 fillCount = MAX<int16>(0, MIN<int16>(destLen, tmp * 2));
 
-					*destPtr++ = srcPtr[j];
-					destLen--;
-				}
-			}
-			srcPtr += 2;
+			if (srcPtr[0] == srcPtr[1])
+				memset(destPtr, srcPtr[0], fillCount);
+			else
+				for (int i = 0; i < fillCount; i++)
+					destPtr[i] = srcPtr[i & 1];
+
+			srcPtr  += 2;
+			destPtr += fillCount;
+			destLen -= fillCount;
 		}
 		srcLen -= tmp;
 	}
@@ -454,11 +455,21 @@ void CoktelDecoder::renderBlockWhole(Graphics::Surface &dstSurf, const byte *src
 
 	rect.clip(dstSurf.w, dstSurf.h);
 
+	const uint32 rowSize  = rect.width()    * dstSurf.format.bytesPerPixel;
+	const uint32 srcPitch = srcRect.width() * dstSurf.format.bytesPerPixel;
+
 	byte *dst = (byte *)dstSurf.pixels + (rect.top * dstSurf.pitch) + rect.left * dstSurf.format.bytesPerPixel;
+
+	if ((rowSize == srcPitch) && (rowSize == dstSurf.pitch)) {
+		// Source and destination rows are contiguous, copy the whole block in one go
+		memcpy(dst, src, rowSize * rect.height());
+		return;
+	}
+
 	for (int i = 0; i < rect.height(); i++) {
-		memcpy(dst, src, rect.width() * dstSurf.format.bytesPerPixel);
+		memcpy(dst, src, rowSize);
 
-		src += srcRect.width() * dstSurf.format.bytesPerPixel;
+		src += srcPitch;
 		dst += dstSurf.pitch;
 	}
 }
@@ -474,14 +485,13 @@ void CoktelDecoder::renderBlockWhole4X(Graphics::Surface &dstSurf, const byte *s
 		      byte *dstRow = dst;
 		const byte *srcRow = src;
 
+		// Write each source pixel four times at once
 		int16 count = rect.width();
-		while (count >= 0) {
-			memset(dstRow, *srcRow, MIN<int16>(count, 4));
+		for (; count >= 4; count -= 4, dstRow += 4)
+			WRITE_UINT32(dstRow, *srcRow++ * 0x01010101U);
 
-			count  -= 4;
-			dstRow += 4;
-			srcRow += 1;
-		}
+		if (count > 0)
+			memset(dstRow, *srcRow, count);
 
 		src += srcRect.width() / 4;
 		dst += dstSurf.pitch;